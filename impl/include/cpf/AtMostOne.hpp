@@ -0,0 +1,31 @@
+#pragma once
+
+#include "ClauseShard.hpp"
+#include "Variable.hpp"
+
+#include <string>
+
+namespace cpf {
+
+/*
+	Ways to encode that at most one variable of a set is true:
+	- Pairwise:   !x_i or !x_j for each pair, n(n-1)/2 clauses and no auxiliary variable
+	- Sequential: Sinz's sequential counter, 3n-4 clauses and n-1 auxiliary variables
+	- Commander:  Klieber and Kwon's commander encoding, groups of 3 variables each represented by a commander on which
+	              the constraint is applied recursively
+	- Product:    Chen's 2-product encoding, variables are laid on a grid and the constraint is applied recursively on
+	              the rows and the columns, about 2n + 4sqrt(n) clauses
+	- Auto:       Pairwise for small sets, Sequential for medium sets and Product for large ones, which needs fewer
+	              auxiliary variables
+*/
+enum class AtMostOneEncoding { Pairwise, Sequential, Commander, Product, Auto };
+
+bool parse_at_most_one_encoding(std::string const& name, AtMostOneEncoding& out);
+
+/*
+	Push the clauses such that at most one variable of [first, last) is true,
+	auxiliary variables are created from the shard when the encoding requires them
+*/
+void push_at_most_one(ClauseShard& shard, Variable const* first, Variable const* last, AtMostOneEncoding encoding);
+
+} // namespace cpf
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Graph.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace cpf {
+
+constexpr std::uint32_t UNREACHABLE_DISTANCE = std::numeric_limits<std::uint32_t>::max();
+
+/*
+	Breadth first search over a graph, computing the distance of every node from a source
+	Its frontiers are allocated once and reused by every search, a node is marked when pushed so it's pushed once.
+	A level is expanded either top-down, from the nodes of the frontier to their unvisited neighbours, or bottom-up,
+	from the unvisited nodes to a neighbour in the frontier (marked in a bitset), which checks fewer edges once the
+	frontier holds most of the edges left to visit. Both give the same distances
+*/
+class BreadthFirstSearch {
+public:
+	enum class Mode {
+		TopDown,
+		// Bottom-up while the frontier is large, as proposed by Beamer et al.
+		DirectionOptimising
+	};
+
+	explicit BreadthFirstSearch(Graph const& graph_, Mode mode_ = Mode::DirectionOptimising);
+
+	/*
+		`distances[v]` is the distance from `source` to v, or UNREACHABLE_DISTANCE
+	*/
+	void run(node_t source, std::vector<std::uint32_t>& distances);
+
+	/*
+		Levels expanded bottom-up by the last search
+	*/
+	std::size_t bottom_up_levels() const noexcept;
+
+private:
+	void top_down_level(std::vector<std::uint32_t>& distances, std::uint32_t distance);
+	void bottom_up_level(std::vector<std::uint32_t>& distances, std::uint32_t distance);
+
+	Graph const* graph;
+	Mode mode;
+	std::size_t degree_sum = 0;
+
+	std::vector<node_t> frontier;
+	std::vector<node_t> next_frontier;
+	// Nodes of `frontier`, only set while expanding bottom-up
+	std::vector<std::uint64_t> in_frontier;
+	// Sum of the degrees of the frontier, and of the unvisited nodes
+	std::size_t frontier_edges	= 0;
+	std::size_t unvisited_edges = 0;
+	std::size_t bottom_up_count = 0;
+};
+
+} // namespace cpf
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Variable.hpp"
+#include <array>
+#include <initializer_list>
 #include <vector>
 
 namespace cpf {
@@ -8,15 +10,29 @@ namespace cpf {
 /*
  	A clause is a series of `or` where each term is a variable negated or not
 	It need to be this way because the solver expect clause in conjunction normal form
+
+	The variables are stored inline, only clauses longer than `INLINE_CAPACITY` allocate
 */
 
 class Clause {
 public:
+	static constexpr std::size_t INLINE_CAPACITY = 8;
+
 	Clause() = default;
 	Clause(Variable const& v);
 	Clause(std::initializer_list<Variable> variables_);
 
-	std::vector<Variable> variables;
+	Clause& push(Variable const& v);
+	void clear() noexcept;
+
+	Variable const* begin() const noexcept;
+	Variable const* end() const noexcept;
+	std::size_t size() const noexcept;
+
+private:
+	std::array<Variable, INLINE_CAPACITY> inline_variables;
+	std::vector<Variable> spilled_variables;
+	std::size_t count = 0;
 };
 
 /*
@@ -26,4 +42,4 @@ Clause operator|(Variable const& lhs, Variable const& rhs);
 Clause& operator|=(Clause& lhs, Variable const& rhs);
 Clause&& operator|(Clause&& lhs, Variable const& rhs);
 
-} // namespace cpf
\ No newline at end of file
+} // namespace cpf
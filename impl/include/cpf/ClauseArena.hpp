@@ -0,0 +1,36 @@
+#pragma once
+
+#include "ClauseSink.hpp"
+#include "Range.hpp"
+
+#include <vector>
+
+namespace cpf {
+
+/*
+	Keep the clauses in a single array of variables, the i-th clause is [offsets[i], offsets[i + 1])
+*/
+class ClauseArena : public ClauseSink {
+public:
+	using ClauseView = Range<Variable>;
+
+	ClauseArena();
+
+	void add_clause(Variable const* first, Variable const* last) override;
+
+	std::size_t size() const noexcept;
+	ClauseView operator[](std::size_t index) const noexcept;
+
+	/*
+		Give the clauses [first_clause, size()) to another sink
+	*/
+	void replay(ClauseSink& sink, std::size_t first_clause = 0) const;
+
+	void clear() noexcept;
+
+private:
+	std::vector<Variable> variables;
+	std::vector<std::size_t> offsets;
+};
+
+} // namespace cpf
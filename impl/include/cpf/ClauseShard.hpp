@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Clause.hpp"
+#include "ClauseArena.hpp"
+
+namespace cpf {
+
+/*
+	Clauses generated apart from the context, typically by another thread, then merged into it with `Context::merge`
+	The auxiliary variables can't take their final id before the merge, they are numbered -2, -3, ... in their order
+	of creation until then
+*/
+class ClauseShard {
+public:
+	Variable create_aux_var() noexcept;
+
+	ClauseShard& push(Clause const& clause);
+
+	/*
+		Final id of the variable once `aux_base` is given to the first auxiliary variable of the shard
+	*/
+	static Variable resolve(Variable var, int aux_base) noexcept;
+
+	ClauseArena const& clauses() const noexcept;
+	int aux_count() const noexcept;
+
+	void clear() noexcept;
+
+private:
+	ClauseArena arena;
+	int auxiliaries = 0;
+};
+
+} // namespace cpf
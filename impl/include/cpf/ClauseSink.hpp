@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Variable.hpp"
+
+namespace cpf {
+
+/*
+	Receive the clauses as they are generated, so they don't need to be stored before being given to the SAT solver
+*/
+class ClauseSink {
+public:
+	virtual ~ClauseSink() = default;
+
+	/*
+		Add the clause made of the variables [first, last), the variables don't need to outlive the call
+	*/
+	virtual void add_clause(Variable const* first, Variable const* last) = 0;
+};
+
+} // namespace cpf
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "Clause.hpp"
+#include "ClauseShard.hpp"
+#include "ClauseSink.hpp"
 #include "Graph.hpp"
+#include "Range.hpp"
 
 #include <cassert>
 #include <iostream>
@@ -9,32 +12,116 @@
 namespace cpf {
 
 /*
-	Holds all the clauses, also make the bridge between variable's id and the tuple (index, agent_id, node)
+	Make the bridge between variable's id and the tuple (index, agent_id, node), and forward the clauses to a sink
+	Only the created variables are stored, each (time, agent_id) keeps its nodes sorted to be searched in O(log k)
 */
 class Context {
 public:
 	Context() = default;
-	Context(std::size_t makespan, std::size_t agent_count_, std::size_t node_count_);
+	/*
+		The sink must outlive the calls to `push`
+	*/
+	Context(std::size_t makespan, std::size_t agent_count_, std::size_t node_count_, ClauseSink& sink_);
 
-	Variable create_var(std::size_t time, std::size_t agent_id, node_t node) noexcept;
+	/*
+		Add the time steps up to `makespan`, existing variables and clauses are kept
+	*/
+	void extend(std::size_t makespan);
+
+	/*
+		Add an agent without any variable, its id is the previous number of agents. The variables of the other agents
+		are kept, but the agents must be indexed again at the time steps where the new one gets variables
+	*/
+	std::size_t add_agent();
+
+	/*
+		Number of time steps, from 0 to the makespan given last
+	*/
+	std::size_t time_steps_count() const noexcept;
+
+	Variable create_var(std::size_t time, std::size_t agent_id, node_t node);
 	Variable get_var(std::size_t time, std::size_t agent_id, node_t node) const noexcept;
 	bool contains(std::size_t time, std::size_t agent_id, node_t node) const noexcept;
 
-	Context& push(Clause clause);
+	/*
+		Variable of `nodes_at(time, agent_id)[index]`, in constant time
+	*/
+	Variable get_var_at(std::size_t time, std::size_t agent_id, std::size_t index) const noexcept;
+
+	/*
+		Nodes having a variable at (time, agent_id), in increasing order
+	*/
+	std::vector<node_t> const& nodes_at(std::size_t time, std::size_t agent_id) const noexcept;
+
+	/*
+		Index, for each node, the agents having a variable on it at `time`
+		Must be called again when variables are created at `time`
+	*/
+	void index_agents(std::size_t time);
+
+	/*
+		Nodes with at least one agent at `time`, in increasing order, require `index_agents(time)`
+	*/
+	std::vector<node_t> const& occupied_nodes(std::size_t time) const noexcept;
+
+	/*
+		Agents having a variable on `node` at `time`, in increasing order, require `index_agents(time)`
+	*/
+	Range<std::size_t> agents_at(std::size_t time, node_t node) const noexcept;
+
+	/*
+		Create a variable that isn't bound to any (time, agent_id, node), used as a selector
+	*/
+	Variable create_aux_var() noexcept;
+
+	/*
+		Variable B(k) meaning that the makespan is at most `k`, B(k) => B(k+1) is pushed for each created variable
+	*/
+	Variable makespan_bound(std::size_t k);
+
+	/*
+		Number of bound variables created so far, B(0) to B(makespan_bounds_count() - 1)
+	*/
+	std::size_t makespan_bounds_count() const noexcept;
+
+	Context& push(Clause const& clause);
+
+	/*
+		Push the clauses of the shard, its auxiliary variables are created in the context beforehand
+	*/
+	Context& merge(ClauseShard const& shard);
 
 	std::size_t variables_count() const noexcept;
 	std::size_t clauses_count() const noexcept;
 
-	std::vector<Clause>::const_iterator begin() const noexcept;
-	std::vector<Clause>::const_iterator end() const noexcept;
-
 private:
-	std::vector<int> variables;
+	struct Layer {
+		std::vector<node_t> nodes;
+		std::vector<int> variables;
+	};
+
+	/*
+		The agents on `nodes[i]` are `agents[offsets[i]]` up to `agents[offsets[i + 1]]`
+	*/
+	struct Occupancy {
+		std::vector<node_t> nodes;
+		std::vector<std::size_t> offsets;
+		std::vector<std::size_t> agents;
+	};
+
+	Layer const& layer(std::size_t time, std::size_t agent_id) const noexcept;
+	int find(std::size_t time, std::size_t agent_id, node_t node) const noexcept;
+
+	std::vector<Layer> layers;
+	std::vector<Occupancy> occupancies;
+	std::vector<Variable> bounds;
 	std::size_t agent_count;
 	std::size_t node_count;
 
 	int next_variable_id = 0;
-	std::vector<Clause> clauses;
+	ClauseSink* sink	 = nullptr;
+	std::size_t clauses	 = 0;
+	std::vector<Variable> merge_buffer;
 };
 
 } // namespace cpf
\ No newline at end of file
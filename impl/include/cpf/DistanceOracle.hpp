@@ -0,0 +1,122 @@
+#pragma once
+
+#include "BreadthFirstSearch.hpp"
+#include "Graph.hpp"
+#include "ThreadPool.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace cpf {
+
+/*
+	Distances from a source node to every node of a graph
+	They are stored on 16 bits when the farthest node reachable is closer than SHORT_UNREACHABLE, on 32 bits otherwise
+*/
+class DistanceTable {
+public:
+	/*
+		The search writes the distances into `buffer`, which is reused by the next tables
+	*/
+	DistanceTable(BreadthFirstSearch& search, std::vector<std::uint32_t>& buffer, node_t source_);
+
+	node_t source() const noexcept;
+
+	/*
+		Distance from the source, or std::numeric_limits<std::size_t>::max() when `node` can't be reached
+	*/
+	std::size_t operator[](node_t node) const noexcept;
+
+	/*
+		Bytes taken by a distance, 2 or 4
+	*/
+	std::size_t distance_size() const noexcept;
+
+private:
+	friend class DistanceOracle;
+
+	static constexpr std::uint16_t SHORT_UNREACHABLE = std::numeric_limits<std::uint16_t>::max();
+
+	DistanceTable() = default;
+
+	node_t source_node = INVALID_NODE;
+	// Only one of them is filled
+	std::vector<std::uint16_t> short_distances;
+	std::vector<std::uint32_t> distances;
+};
+
+/*
+	Distance tables of a graph, each computed once per source node and shared by whoever asks for it: the agents with
+	the same goal, the groups planned one after the other, or the requests on the same graph. The graph must outlive
+	the oracle. Thread safe
+	The tables can be saved and loaded back on a later run, the file is tied to the graph by its hash
+*/
+class DistanceOracle {
+public:
+	/*
+		Beyond `max_tables_` tables, all of them are dropped (the ones in use stay alive)
+	*/
+	explicit DistanceOracle(
+		Graph const& graph_,
+		std::size_t max_tables_		   = std::numeric_limits<std::size_t>::max(),
+		BreadthFirstSearch::Mode mode_ = BreadthFirstSearch::Mode::DirectionOptimising);
+
+	DistanceOracle(DistanceOracle const&) = delete;
+	DistanceOracle& operator=(DistanceOracle const&) = delete;
+
+	Graph const& graph() const noexcept;
+
+	/*
+		Table of the distances from `source`, computed on the first call
+	*/
+	std::shared_ptr<DistanceTable const> distances_from(node_t source);
+
+	/*
+		Compute the table of every node on the pool, i.e. all the pairs: V tables of V distances, so at least 2V² bytes
+		(about 5GB for 50000 nodes) and twice as much when the graph's diameter doesn't fit on 16 bits
+	*/
+	void compute_all(ThreadPool& pool);
+
+	std::size_t table_count() const;
+
+	/*
+		Write the tables computed so far, in a binary format of the host's endianness
+	*/
+	void save(std::ostream& os) const;
+
+	/*
+		Read the tables written by `save`, false (and nothing read) when they aren't of this graph
+	*/
+	bool load(std::istream& is);
+
+private:
+	/*
+		A search and its distance buffer, taken by one computation at a time
+	*/
+	struct Search {
+		Search(Graph const& graph, BreadthFirstSearch::Mode mode);
+
+		BreadthFirstSearch bfs;
+		std::vector<std::uint32_t> buffer;
+	};
+
+	void insert(std::shared_ptr<DistanceTable const> table);
+
+	Graph const* graph_ptr;
+	std::uint64_t graph_hash;
+	std::size_t max_tables;
+	BreadthFirstSearch::Mode mode;
+
+	mutable std::mutex mutex;
+	// Indexed by source node, null until computed
+	std::vector<std::shared_ptr<DistanceTable const>> tables;
+	std::size_t tables_count = 0;
+	// Searches not running, each concurrent computation takes one, so their buffers are reused
+	std::vector<std::unique_ptr<Search>> idle_searches;
+};
+
+} // namespace cpf
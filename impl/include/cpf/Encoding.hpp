@@ -0,0 +1,90 @@
+#pragma once
+
+#include "AtMostOne.hpp"
+#include "ClauseShard.hpp"
+#include "Context.hpp"
+#include "Graph.hpp"
+#include "LayeredMDD.hpp"
+
+#include <vector>
+
+namespace cpf {
+
+/*
+	Families of clauses of the encoding, each generated for a single time step over a range of agents or of occupied
+	nodes into a shard, so they can be generated apart from the context. X(t, a, v) is the variable of the agent a
+	on the node v at the time step t
+*/
+
+/*
+	Clause #1
+	!X(t, a, v) or X(t+1, a, v) or OR(u, u -> v exists) X(t+1, a, u)
+*/
+void push_movement_clauses(
+	Context const& context,
+	ClauseShard& shard,
+	Graph const& graph,
+	std::size_t t,
+	std::size_t a_begin,
+	std::size_t a_end);
+
+/*
+	Clause #1 along the edges of the layered mdds only, the variables of each agent at t and t+1 being the nodes of the
+	layers t and t+1 of its mdd: !X(t, a, v) or OR(u successor of v in the mdd) X(t+1, a, u)
+*/
+void push_mdd_movement_clauses(
+	Context const& context,
+	ClauseShard& shard,
+	std::vector<LayeredMDD> const& mdds,
+	std::size_t t,
+	std::size_t a_begin,
+	std::size_t a_end);
+
+/*
+	Clause #2
+	At most one of X(t, a, v) for all a
+	Only the agents indexed on each node are considered, for the occupied nodes [first, last) of t
+*/
+void push_vertex_conflict_clauses(
+	Context const& context,
+	ClauseShard& shard,
+	std::size_t t,
+	std::size_t first,
+	std::size_t last,
+	AtMostOneEncoding encoding);
+
+/*
+	Clause #3
+	At most one of X(t, a, v) for all v
+*/
+void push_single_position_clauses(
+	Context const& context,
+	ClauseShard& shard,
+	std::size_t t,
+	std::size_t a_begin,
+	std::size_t a_end,
+	AtMostOneEncoding encoding);
+
+/*
+	Clause #4
+	!X(t, a, v) or !X(t+1, a, u) or !X(t, b, u) or !X(t+1, b, v)
+	Only the edges between occupied nodes are visited, each edge {v, u} once with v < u, a moving from v to u and
+	b from u to v, for the occupied nodes [first, last) of t. Requires the agents to be indexed for t and t+1
+*/
+void push_swap_conflict_clauses(
+	Context const& context,
+	ClauseShard& shard,
+	Graph const& graph,
+	std::size_t t,
+	std::size_t first,
+	std::size_t last);
+
+/*
+	Clauses #2 and #4 of the agent `a` alone against each other agent, pairwise: the vertex conflicts at t and the
+	swap conflicts between t and t+1, for an agent added once the conflicts of the others are already encoded.
+	Requires the agents to be indexed for t and t+1
+*/
+void push_agent_conflict_clauses(
+	Context const& context, ClauseShard& shard, Graph const& graph, std::size_t t, std::size_t a);
+
+} // namespace cpf
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Agent.hpp"
+#include "Graph.hpp"
+
+#include <string>
+#include <vector>
+
+namespace cpf {
+
+/*
+	Polynomial checks rejecting the instances proven to have no solution, in linear time. Passing them doesn't prove
+	that a solution exists:
+	- the initial nodes, and the goal nodes, are distinct nodes of the graph
+	- each goal is in the connected component of the initial node of its agent
+	- nothing can move in a component without cycle and without free node, its agents must already be on their goal
+	- the agents of a path can't overtake each other, they must keep their order along it
+	Return why there is no solution, or an empty string
+*/
+std::string find_infeasibility(Graph const& graph, std::vector<Agent> const& agents);
+
+} // namespace cpf
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -10,10 +11,38 @@
 namespace cpf {
 
 /*
-    Read and write CPF files
+    Read and write CPF files, in the text format or in the binary one
+    The binary format, in the host's endianness, is a versioned header followed by the compressed sparse row of the
+    graph (its offsets, then the neighbours of each node) and the agents (initial then goal node), all as 64 bits words,
+    so a mapped file is used as is by the graph
+*/
+
+enum class FileFormat { Text, Binary };
+
+/*
+    Format of the CPF instance starting at the next character of `is`, which isn't consumed
+*/
+FileFormat detect_format(std::istream& is);
+
+/*
+    Read a CPF instance in either format, throw std::runtime_error when it can't be parsed
 */
 std::pair<Graph, std::vector<Agent>> deserialize(std::istream& is);
 
+/*
+    Read a CPF instance held by the `size` bytes of `data`, in either format (a binary one is copied)
+    Throw std::runtime_error when it can't be parsed
+*/
+std::pair<Graph, std::vector<Agent>> deserialize(char const* data, std::size_t size);
+
+/*
+    Read the CPF file `filename` in either format. The file is mapped in memory: a text file is parsed in place, the
+    graph of a binary file uses it without copy. Throw std::runtime_error when the file can't be read or parsed
+*/
+std::pair<Graph, std::vector<Agent>> deserialize_file(std::string const& filename);
+
 void serialize(std::ostream& os, Graph const& graph, std::vector<Agent> const& agents);
 
-} // namespace cpf
\ No newline at end of file
+void serialize_binary(std::ostream& os, Graph const& graph, std::vector<Agent> const& agents);
+
+} // namespace cpf
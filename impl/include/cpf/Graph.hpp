@@ -1,7 +1,12 @@
 #pragma once
 
+#include "Range.hpp"
+
 #include <algorithm>
+#include <cstdint>
 #include <limits>
+#include <memory>
+#include <utility>
 #include <vector>
 
 namespace cpf {
@@ -9,21 +14,51 @@ namespace cpf {
 using node_t				  = std::size_t;
 constexpr node_t INVALID_NODE = std::numeric_limits<node_t>::max();
 
+using edge_t = std::pair<node_t, node_t>;
+
+/*
+	Undirected graph stored as a compressed sparse row:
+	the neighbours of `node` are `neighbours[offsets[node]]` up to `neighbours[offsets[node + 1]]`, sorted
+	The rows are immutable and shared by the copies of the graph
+*/
 class Graph {
 public:
-	Graph(std::size_t node_count_) noexcept;
+	using Neighbours = Range<node_t>;
+
+	Graph(std::size_t node_count_ = 0);
+	Graph(std::size_t node_count_, std::vector<edge_t> edges);
 
-	typename std::vector<bool>::const_reference operator[](std::pair<node_t, node_t> p) const noexcept;
-	typename std::vector<bool>::reference operator[](std::pair<node_t, node_t> p) noexcept;
+	/*
+		Graph over rows stored elsewhere, e.g. in a mapped file, kept alive by `storage_`: `offsets_` holds
+		`node_count_ + 1` offsets and `neighbours_` the `offsets_[node_count_]` sorted neighbours, as the graphs built
+		from edges. Nothing is copied nor checked
+	*/
+	Graph(
+		std::size_t node_count_,
+		std::size_t edges_count_,
+		std::size_t const* offsets_,
+		node_t const* neighbours_,
+		std::shared_ptr<void const> storage_);
+
+	bool operator[](edge_t p) const noexcept;
 
 	std::size_t size() const noexcept;
 	std::size_t edge_count() const noexcept;
 
-	std::vector<node_t> neighbours_of(node_t node) const noexcept;
+	Neighbours neighbours_of(node_t node) const noexcept;
 
 private:
-	std::vector<bool> edges;
+	// Owner of the rows, the graph itself when built from edges
+	std::shared_ptr<void const> storage;
+	std::size_t const* offsets;
+	node_t const* neighbours;
 	std::size_t node_count;
+	std::size_t edges_count = 0;
 };
 
-} // namespace cpf
\ No newline at end of file
+/*
+	FNV-1a hash of the number of nodes and of the neighbours of each node, for the caches keyed by graph
+*/
+std::uint64_t hash_graph(Graph const& graph) noexcept;
+
+} // namespace cpf
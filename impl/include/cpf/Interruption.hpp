@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+
+namespace cpf {
+
+/*
+	Solver which can be stopped while it runs
+*/
+class Interruptible {
+public:
+	virtual ~Interruptible() = default;
+
+	/*
+		Make the running solve return as soon as possible, may be called from a signal handler or another thread
+	*/
+	virtual void interrupt() noexcept = 0;
+};
+
+/*
+	Request to stop a search, e.g. on SIGINT: the solver it watches is interrupted, and the search checks `requested()`
+	before starting anything new. A request is never withdrawn
+	Everything `interrupt` touches is lock-free, so it can be called from a signal handler
+*/
+class Interruption {
+public:
+	/*
+		Return whether a solver was watched, and so interrupted
+	*/
+	bool interrupt() noexcept;
+
+	bool requested() const noexcept;
+
+	/*
+		Interrupt `solver` along with the search until `release`, the solver must outlive the call to `release`
+	*/
+	void watch(Interruptible& solver) noexcept;
+
+	void release() noexcept;
+
+private:
+	static_assert(
+		ATOMIC_BOOL_LOCK_FREE == 2 && ATOMIC_POINTER_LOCK_FREE == 2,
+		"An interruption must be usable in a signal handler");
+
+	std::atomic<bool> stop{ false };
+	std::atomic<Interruptible*> watched{ nullptr };
+};
+
+} // namespace cpf
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Graph.hpp"
+#include "MDD.hpp"
+#include "Range.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace cpf {
+
+/*
+	MDD of an agent materialised as time layers: the layer t holds, in increasing order, the nodes the agent can occupy
+	at the time step t on a path from its initial node to its goal of makespan at most `max_makespan`. Each node of a
+	layer has the indices, in the next layer, of the nodes it can move to (itself, when waiting, and its neighbours)
+	The layers are built on demand by `extend`, so an unknown makespan bound only costs the layers actually used
+	Nodes can be removed, e.g. when they can't be part of a plan for other reasons, then `prune` removes the nodes
+	left without successor or predecessor
+*/
+class LayeredMDD {
+public:
+	static constexpr std::size_t NOT_IN_LAYER = std::numeric_limits<std::size_t>::max();
+
+	/*
+		The graph must outlive the mdd
+	*/
+	LayeredMDD(Graph const& graph_, MDD mdd_, node_t initial, std::size_t max_makespan_);
+
+	std::size_t max_makespan() const noexcept;
+
+	/*
+		See `MDD::distance_to_goal`
+	*/
+	std::size_t distance_to_goal(node_t node) const noexcept;
+
+	/*
+		Build the layers up to the layer `t`, and the successors of the layers before it
+	*/
+	void extend(std::size_t t);
+
+	/*
+		Layers built so far, 0 to `layers_count() - 1`
+	*/
+	std::size_t layers_count() const noexcept;
+
+	std::vector<node_t> const& layer(std::size_t t) const noexcept;
+
+	/*
+		Indices in the layer t+1 of the successors of `layer(t)[index]`, in increasing order. Requires the layer t+1
+	*/
+	Range<std::uint32_t> successors(std::size_t t, std::size_t index) const noexcept;
+
+	/*
+		Index of `node` in the layer t, or NOT_IN_LAYER
+	*/
+	std::size_t index_of(std::size_t t, node_t node) const noexcept;
+
+	/*
+		Mark `layer(t)[index]` to be removed by the next call to `prune`
+	*/
+	void remove(std::size_t t, std::size_t index);
+
+	/*
+		Remove the marked nodes, then the nodes left without successor (except in the last layer) or without
+		predecessor, until none is left. The indices of the remaining nodes change. Return the number of nodes removed
+	*/
+	std::size_t prune();
+
+	/*
+		Nodes of all the layers
+	*/
+	std::size_t size() const noexcept;
+
+private:
+	struct Layer {
+		std::vector<node_t> nodes;
+		// The successors of `nodes[i]` are `successors[offsets[i]]` up to `successors[offsets[i + 1]]`
+		std::vector<std::uint32_t> offsets;
+		std::vector<std::uint32_t> successors;
+		std::vector<bool> removed;
+	};
+
+	void link(std::size_t t);
+
+	Graph const* graph;
+	MDD mdd;
+	std::size_t max_makespan_bound;
+	std::vector<Layer> layers;
+};
+
+} // namespace cpf
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "AtMostOne.hpp"
+#include "Context.hpp"
+#include "Graph.hpp"
+#include "MakespanSolver.hpp"
+#include "Variable.hpp"
+
+#include <glucose-syrup-4.1/simp/SimpSolver.h>
+
+#include <vector>
+
+namespace cpf {
+
+/*
+	Lazy conflicts: for each collision of the plan in `res`, up to `makespan`, push the conflict clauses (#2 or #4) of
+	the node where it happens, for all the agents, so no plan collides there again
+	Return the number of clauses pushed, 0 when no agents collide
+*/
+std::size_t push_violated_conflicts(
+	Context& context,
+	Graph const& graph,
+	std::size_t agent_count,
+	std::size_t makespan,
+	AtMostOneEncoding amo_encoding,
+	std::vector<bool> const& res);
+
+/*
+	Solve under `assumptions` with the lazy conflicts: the conflict clauses violated by the plan found are added, then
+	the solver tries again, until a plan has no collision or no plan is left
+*/
+Glucose::lbool solve_lazily(
+	IncrementalSolver& solver,
+	Context& context,
+	Graph const& graph,
+	std::size_t agent_count,
+	std::size_t makespan,
+	AtMostOneEncoding amo_encoding,
+	std::vector<Variable> const& assumptions,
+	std::vector<bool>& res);
+
+} // namespace cpf
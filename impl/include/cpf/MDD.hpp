@@ -1,39 +1,30 @@
 #pragma once
 
 #include "Agent.hpp"
+#include "DistanceOracle.hpp"
 #include "Graph.hpp"
 
-#include <iostream>
 #include <limits>
-#include <vector>
+#include <memory>
 
 namespace cpf {
 
 /*
-	Class encapsulating a MDD, which is also able to iteratively increment the distance
+	Distances of every node to the goal of an agent, from which its MDD for any makespan follows: the node v can be
+	occupied at the time step t when t + distance_to_goal(v) doesn't exceed the makespan
+	The table is the oracle's one for the goal, shared by the agents with the same goal
 */
 class MDD {
 private:
-	struct Distance {
-		std::size_t from_initial = std::numeric_limits<std::size_t>::max();
-		std::size_t from_goal	 = std::numeric_limits<std::size_t>::max();
-	};
-
-	Agent agent;
-	Graph const* graph;
-	std::vector<Distance> nodes_to_distances;
-	std::vector<node_t> next_nodes_initial;
-	std::vector<node_t> next_nodes_goal;
-	std::size_t next_distance = 0;
+	std::shared_ptr<DistanceTable const> from_goal;
 
 public:
-	MDD(Graph const& graph_, Agent const& agent_) noexcept;
-
-	void step() noexcept;
-
-	void step_until(std::size_t makespan);
+	MDD(DistanceOracle& oracle, Agent const& agent);
 
-	bool accessible(node_t node, std::size_t time, std::size_t makespan);
+	/*
+		Distance to the goal, or std::numeric_limits<std::size_t>::max() when the goal can't be reached
+	*/
+	std::size_t distance_to_goal(node_t node) const noexcept;
 };
 
-} // namespace cpf
\ No newline at end of file
+} // namespace cpf
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace cpf {
+
+/*
+	Ways to choose the makespans given to the SAT solver, from a lower bound up to an upper bound:
+	- Linear:      each makespan in increasing order, the first solvable one is the optimal one
+	- Exponential: the step between two makespans doubles until one is solvable, then a binary search between the
+	               last unsolvable makespan and the solvable one
+	- Geometric:   the makespan itself is multiplied by 3/2 until one is solvable, then the same binary search
+*/
+enum class SearchStrategy { Linear, Exponential, Geometric };
+
+bool parse_search_strategy(std::string const& name, SearchStrategy& out);
+
+/*
+	Keep the range of makespans which may still be the optimal one, and choose the next one to try
+	A makespan proven unsolvable implies that all the smaller ones are unsolvable
+*/
+class MakespanSearch {
+public:
+	MakespanSearch(SearchStrategy strategy_, std::size_t lower_bound, std::size_t upper_bound_) noexcept;
+
+	/*
+		Either the optimal makespan is known, or there's none within the bounds
+	*/
+	bool done() const noexcept;
+
+	/*
+		Makespan to try next, requires !done()
+	*/
+	std::size_t next() const noexcept;
+
+	/*
+		Result of the makespan returned by `next()`
+	*/
+	void report(bool solvable) noexcept;
+
+	bool found() const noexcept;
+
+	/*
+		Smallest solvable makespan found so far, requires found()
+	*/
+	std::size_t best() const noexcept;
+
+private:
+	SearchStrategy strategy;
+	// Smallest makespan not proven unsolvable
+	std::size_t lowest;
+	// Smallest solvable makespan, or upper_bound + 1
+	std::size_t solvable;
+	std::size_t upper_bound;
+	// Distance between `lowest` and the next makespan tried, while no solvable makespan is known
+	std::size_t step = 1;
+	std::size_t current;
+};
+
+} // namespace cpf
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "ClauseArena.hpp"
+#include "Context.hpp"
+#include "Graph.hpp"
+#include "Interruption.hpp"
+#include "SolverSink.hpp"
+#include "Variable.hpp"
+
+#include <glucose-syrup-4.1/simp/SimpSolver.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cpf {
+
+/*
+	Values of the variables in a model of glucose, indexed by variable id
+*/
+void extract_model(Glucose::vec<Glucose::lbool> const& model, std::vector<bool>& res);
+
+/*
+	Solver dedicated to a single makespan, the clauses generated so far are given to it once the context is extended
+*/
+struct MakespanSolver : Interruptible {
+	Glucose::SimpSolver solver;
+	SolverSink sink;
+
+	explicit MakespanSolver(Interruption& interruption_);
+
+	/*
+		Force `var` to true, the clauses given afterwards are simplified by glucose accordingly
+	*/
+	void fix(Variable var);
+
+	/*
+		Make the solver try the value of `var` first, variables not given to the solver are ignored
+	*/
+	void hint(Variable var);
+
+	/*
+		Solve while watched by the interruption
+	*/
+	bool solve(std::vector<bool>& res);
+
+	/*
+		Solve without being watched by the interruption, the caller is in charge of interrupting it
+		l_True with the model in `res`, l_False when there's no solution, l_Undef when interrupted
+	*/
+	Glucose::lbool solve_limited(std::vector<bool>& res);
+
+	void interrupt() noexcept override;
+
+private:
+	Interruption* interruption;
+};
+
+/*
+	Keep a single solver alive across the makespans, the clauses are given once, when the context is extended
+	The goal constraints of each makespan are enabled through an assumption on its bound variable B(makespan)
+*/
+struct IncrementalSolver : Interruptible {
+	Glucose::SimpSolver solver;
+	SolverSink sink;
+
+	explicit IncrementalSolver(Interruption& interruption_);
+
+	/*
+		Solve the makespan of the bound variable `bound`. When it's proven impossible, so are the smaller makespans and
+		!bound is added for good, nothing is added when interrupted
+	*/
+	bool solve(Variable bound, std::vector<bool>& res);
+
+	/*
+		Force `var` to true, for a solver given the clauses of a single makespan
+	*/
+	void fix(Variable var);
+
+	void hint(Variable var);
+
+	/*
+		l_True with the model in `res`, l_False when there's no solution under `assumptions`, l_Undef when interrupted
+		Nothing is added on failure, so the assumptions can be relaxed afterwards
+	*/
+	Glucose::lbool solve_assuming(std::vector<Variable> const& assumptions, std::vector<bool>& res);
+
+	void interrupt() noexcept override;
+
+private:
+	Interruption* interruption;
+};
+
+/*
+	Phase hints: the solver first tries to put each agent on its path in `hints`, then on the last node of the path
+	once it's over, for the time steps [first_time, last_time]. An empty path gives no hint
+*/
+template<typename HintedSolver>
+void hint_paths(
+	HintedSolver& solver,
+	Context const& context,
+	std::vector<std::vector<node_t>> const& hints,
+	std::size_t first_time,
+	std::size_t last_time) {
+	for (std::size_t a = 0; a < hints.size(); ++a) {
+		if (hints[a].empty())
+			continue;
+
+		for (auto t = first_time; t <= last_time; ++t) {
+			auto v = hints[a][std::min(t, hints[a].size() - 1)];
+			if (context.contains(t, a, v)) {
+				solver.hint(context.get_var(t, a, v));
+			}
+		}
+	}
+}
+
+/*
+	Give the clauses generated so far to a solver dedicated to `makespan`. The bounds are fixed first so the variables
+	too far from the goal are dropped while the clauses are added
+*/
+template<typename SingleMakespanSolver>
+void load_makespan(
+	SingleMakespanSolver& solver,
+	Context& context,
+	ClauseArena const& arena,
+	std::size_t makespan,
+	std::vector<std::vector<node_t>> const& hints) {
+	for (auto k = makespan; k < context.makespan_bounds_count(); ++k) { solver.fix(context.makespan_bound(k)); }
+	arena.replay(solver.sink);
+	hint_paths(solver, context, hints, 0, makespan);
+}
+
+template<typename SingleMakespanSolver>
+bool solve_makespan(
+	SingleMakespanSolver& solver,
+	Context& context,
+	ClauseArena const& arena,
+	std::size_t makespan,
+	std::vector<std::vector<node_t>> const& hints,
+	std::vector<bool>& res) {
+	load_makespan(solver, context, arena, makespan, hints);
+	return solver.solve(res);
+}
+
+} // namespace cpf
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "LayeredMDD.hpp"
+#include "ThreadPool.hpp"
+
+#include <vector>
+
+namespace cpf {
+
+/*
+	Pairwise pruning of the mdds of the agents, all extended up to their max makespan (the same for all of them): a
+	node of an agent is removed when no pair of paths of this agent and of another one going through it is free of
+	vertex and swap conflicts. The pairs are found in the joint mdd of the two agents, only for the agents whose mdds
+	share a node at some time step. The pairs are checked on the pool against the mdds as given, then the removed nodes
+	are pruned, see `LayeredMDD::prune`, so the result doesn't depend on the number of threads
+	Return the number of nodes removed. When two agents can't reach their goals together, their mdds are left empty
+*/
+std::size_t prune_pairwise(std::vector<LayeredMDD>& mdds, ThreadPool& pool);
+
+} // namespace cpf
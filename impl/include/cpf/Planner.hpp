@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Agent.hpp"
+#include "AtMostOne.hpp"
+#include "DistanceOracle.hpp"
+#include "Graph.hpp"
+#include "Interruption.hpp"
+#include "MakespanSearch.hpp"
+#include "ThreadPool.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace cpf {
+
+/*
+	What is minimised: the makespan, or then the sum of the times at which the agents reach their goal for good,
+	without changing the makespan
+*/
+enum class Objective { Makespan, SumOfCosts };
+
+/*
+	Options of the search of a plan, the same for all the groups of agents
+*/
+struct PlanningOptions {
+	std::pair<int, int> makespan_interval;
+	bool use_mdd;
+	bool use_incremental;
+	AtMostOneEncoding amo_encoding;
+	SearchStrategy search_strategy;
+	int solver_threads;
+	std::size_t speculative_window;
+	bool lazy_conflicts;
+	bool use_hints;
+	bool pairwise_pruning;
+	Objective objective;
+};
+
+enum class PlanStatus { Solved, NoSolution, Interrupted };
+
+/*
+	Search the plan of smallest makespan of `agents`, `paths[a][t]` is the node of agent a at time t, from 0 to the
+	makespan
+	With the phase hints, the solvers first try the paths in `hints` (indexed by agent), and the shortest path of the
+	agents without one
+	The distances to the goals are looked up in `oracle`, of the same graph. The clauses are generated on
+	`generation_pool`, and the search stops once `interruption` is requested
+*/
+PlanStatus plan(
+	Graph const& graph,
+	std::vector<Agent> const& agents,
+	PlanningOptions const& options,
+	ThreadPool& generation_pool,
+	DistanceOracle& oracle,
+	std::vector<std::vector<node_t>> hints,
+	Interruption& interruption,
+	std::vector<std::vector<node_t>>& paths);
+
+/*
+	Independence detection: each agent is planned alone, then the groups of two colliding agents are merged and planned
+	together, until the paths of all the groups are compatible. The makespan of a group can't be larger than the one
+	of all the agents, so the largest makespan of the groups is still the smallest one
+	The paths are extended to the same length, the agents waiting on their goal
+	The groups share the distances of `oracle`
+*/
+PlanStatus plan_independent_groups(
+	Graph const& graph,
+	std::vector<Agent> const& agents,
+	PlanningOptions const& options,
+	ThreadPool& generation_pool,
+	DistanceOracle& oracle,
+	std::vector<std::vector<node_t>> const& hints,
+	Interruption& interruption,
+	std::vector<std::vector<node_t>>& paths);
+
+} // namespace cpf
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Agent.hpp"
+#include "AtMostOne.hpp"
+#include "DistanceOracle.hpp"
+#include "Graph.hpp"
+#include "ThreadPool.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cpf {
+
+/*
+	Long running planner answering many requests, typically on the same few graphs, each solved by a `Replanner`.
+	A request is a CPF instance between a line "solve <id>" and a line "end". Its answer is a line
+	"plan <id> <status>", the path of each agent in the format of --output when a plan is found, then a line "end".
+	The status is one of:
+	- solved <makespan>
+	- no-solution
+	- error <message>, when the request can't be read
+	The requests already received are solved together, each on a worker of the pool, and answered in their order.
+	The graphs are cached by content, and with each graph the distance tables computed for the agents planned on it
+*/
+class PlanningService {
+public:
+	PlanningService(std::size_t worker_count, AtMostOneEncoding amo_encoding_, std::size_t max_makespan_);
+
+	/*
+		Answer the requests of `is` on `os` until the end of `is`
+	*/
+	void serve(std::istream& is, std::ostream& os);
+
+private:
+	struct Request {
+		std::string id;
+		std::string instance;
+		// Set when the request is malformed, it's answered with this error
+		std::string error;
+	};
+
+	struct CachedGraph {
+		Graph graph;
+		std::shared_ptr<DistanceOracle> oracle;
+		std::size_t last_use = 0;
+	};
+
+	bool read_request(std::istream& is, Request& request) const;
+	std::string answer(Request const& request);
+	std::shared_ptr<CachedGraph> find_graph(Graph graph);
+
+	ThreadPool pool;
+	AtMostOneEncoding amo_encoding;
+	std::size_t max_makespan;
+
+	std::mutex graphs_mutex;
+	std::map<std::uint64_t, std::shared_ptr<CachedGraph>> graphs;
+	std::size_t uses = 0;
+};
+
+} // namespace cpf
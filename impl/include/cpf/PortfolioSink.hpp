@@ -0,0 +1,26 @@
+#pragma once
+
+#include "ClauseSink.hpp"
+
+#include <glucose-syrup-4.1/parallel/MultiSolvers.h>
+
+namespace cpf {
+
+/*
+	Give the clauses to glucose-syrup's portfolio, creating the solvers' variables as needed
+	The clauses must all be given before the portfolio starts solving
+*/
+class PortfolioSink : public ClauseSink {
+public:
+	PortfolioSink(Glucose::MultiSolvers& solvers_) noexcept;
+
+	void add_clause(Variable const* first, Variable const* last) override;
+
+	Glucose::Lit to_lit(Variable const& var);
+
+private:
+	Glucose::MultiSolvers* solvers;
+	Glucose::vec<Glucose::Lit> buffer;
+};
+
+} // namespace cpf
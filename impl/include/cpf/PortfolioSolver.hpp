@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Interruption.hpp"
+#include "PortfolioSink.hpp"
+#include "Variable.hpp"
+
+#include <glucose-syrup-4.1/parallel/MultiSolvers.h>
+
+#include <vector>
+
+namespace cpf {
+
+/*
+	Glucose-syrup's portfolio dedicated to a single makespan: `thread_count` differently configured solvers sharing
+	their short learnt clauses, the first one to finish gives the answer
+	MultiSolvers can only solve once, and is only given the clauses of its makespan
+*/
+struct PortfolioSolver : Glucose::MultiSolvers, Interruptible {
+	PortfolioSink sink;
+
+	PortfolioSolver(int thread_count, Interruption& interruption_);
+	~PortfolioSolver();
+
+	void fix(Variable var);
+
+	/*
+		The solvers of the portfolio are cloned from the first one when solving, with its polarities
+	*/
+	void hint(Variable var);
+
+	/*
+		Solve while watched by the interruption
+	*/
+	bool solve(std::vector<bool>& res);
+
+	/*
+		Interrupt all the solvers of the portfolio
+	*/
+	void interrupt() noexcept override;
+
+private:
+	Interruption* interruption;
+};
+
+} // namespace cpf
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Agent.hpp"
+#include "Graph.hpp"
+
+#include <vector>
+
+namespace cpf {
+
+/*
+	Plan the agents one after the other with a breadth first search in space and time, each one avoiding the paths of
+	the previous ones and waiting on its goal once there. An agent blocked by the previous ones is planned first on the
+	next attempt, up to one attempt per agent. The plan is found fast but isn't optimal, and the search is incomplete:
+	false doesn't mean that there is no solution
+	`paths[a][t]` is the node of agent a at time t, all the paths have the same length
+*/
+bool plan_prioritized(Graph const& graph, std::vector<Agent> const& agents, std::vector<std::vector<node_t>>& paths);
+
+} // namespace cpf
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+namespace cpf {
+
+/*
+	Non-owning view over contiguous elements
+*/
+template<typename T>
+class Range {
+public:
+	constexpr Range(T const* first_, T const* last_) noexcept : first{ first_ }, last{ last_ } {}
+
+	constexpr T const* begin() const noexcept { return first; }
+	constexpr T const* end() const noexcept { return last; }
+	constexpr std::size_t size() const noexcept { return static_cast<std::size_t>(last - first); }
+	constexpr bool empty() const noexcept { return first == last; }
+
+private:
+	T const* first;
+	T const* last;
+};
+
+} // namespace cpf
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Agent.hpp"
+#include "AtMostOne.hpp"
+#include "Context.hpp"
+#include "DistanceOracle.hpp"
+#include "Graph.hpp"
+#include "MDD.hpp"
+#include "SolverSink.hpp"
+
+#include <glucose-syrup-4.1/simp/SimpSolver.h>
+
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace cpf {
+
+/*
+	Changes of an instance between two plans, applied in this order:
+	- the first `elapsed` time steps of the last plan are done, each agent starts from where that plan puts it
+	- the agents of `removed_agents` leave
+	- the agents of `new_goals` get another goal
+	- the agents of `added_agents` enter on their initial node, their ids follow the ones of the existing agents
+	- the edges of `blocked_edges`, and the edges of the nodes of `blocked_nodes`, can't be used anymore
+*/
+struct Delta {
+	std::size_t elapsed = 0;
+	std::vector<std::size_t> removed_agents;
+	std::vector<std::pair<std::size_t, node_t>> new_goals;
+	std::vector<Agent> added_agents;
+	std::vector<edge_t> blocked_edges;
+	std::vector<node_t> blocked_nodes;
+};
+
+/*
+	Read a delta, one change per line: "elapsed <time steps>", "remove <agent>", "goal <agent> <node>",
+	"add <initial> <goal>", "block <node> <node>" or "obstacle <node>". Empty lines and lines starting with '#' are
+	skipped, anything else throws a std::runtime_error
+*/
+Delta read_delta(std::istream& is);
+
+/*
+	Planning session kept alive while the instance changes, each plan is of smallest makespan for the instance at the
+	time. The encoding of `plan` is kept across the changes: nothing is ever removed from the SAT solver, so the
+	clauses it learnt stay valid and only what a change affects is added:
+	- the constraints specific to an agent (its goal, and the distances to its goal pruning its variables) are guarded
+	  by a selector assumed while the agent keeps this goal, removing the agent or changing its goal retires the
+	  selector for good
+	- the initial nodes are assumptions on the time step `origin`, the time steps already done are left free
+	- a blocked edge forbids the moves along it, and only the mdds of the agents for which it's on a shortest path to
+	  the goal are computed again, the distances which grew being pushed as extra clauses
+	- an added agent gets its variables and its clauses on the existing time steps, and pairwise conflict clauses
+	  against the others
+	The last plan found, or the one given to `warm_start`, is the solver's phase hint
+*/
+class Replanner {
+public:
+	enum class Status { Solved, NoSolution, Interrupted };
+
+	/*
+		Makespans larger than `max_makespan_` (from the current time step) aren't tried
+	*/
+	Replanner(Graph graph_, std::vector<Agent> agents_, AtMostOneEncoding amo_encoding_, std::size_t max_makespan_);
+
+	/*
+		With the distances of `oracle_`, e.g. shared by the instances on the same graph, its graph must be the same as
+		`graph_`. Null for an oracle of its own
+	*/
+	Replanner(
+		Graph graph_,
+		std::vector<Agent> agents_,
+		std::shared_ptr<DistanceOracle> oracle_,
+		AtMostOneEncoding amo_encoding_,
+		std::size_t max_makespan_);
+
+	Replanner(Replanner const&) = delete;
+	Replanner& operator=(Replanner const&) = delete;
+
+	/*
+		Plan previously found for the current instance, in the format of `plan`, tried first by the solver and
+		followed by `Delta::elapsed`
+	*/
+	void warm_start(std::vector<std::vector<node_t>> paths);
+
+	/*
+		Throw a std::runtime_error when the delta refers to unknown agents or nodes, or to agents which left
+	*/
+	void apply(Delta const& delta);
+
+	/*
+		`paths[a][t]` is the node of agent a, t time steps after the last elapsed one, up to the makespan, the paths of
+		the agents which left are empty
+	*/
+	Status plan(std::vector<std::vector<node_t>>& paths);
+
+	/*
+		Stop the current call to `plan`, can be called from a signal handler
+	*/
+	void interrupt();
+
+	Graph const& current_graph() const noexcept;
+
+	/*
+		The agents, the initial node being where the agent is now
+	*/
+	std::vector<Agent> const& current_agents() const noexcept;
+
+	bool is_active(std::size_t agent_id) const noexcept;
+
+private:
+	bool encoded() const noexcept;
+
+	void extend_to(std::size_t makespan);
+	void create_agent_variables(std::size_t t, std::size_t a);
+	void push_goal_clause(std::size_t t, std::size_t a);
+	void push_distance_guards(std::size_t a, MDD const* previous_mdd);
+	void push_distance_guard(std::size_t t, std::size_t a, node_t v, std::size_t distance);
+
+	void advance(std::size_t elapsed);
+	void remove_agent(std::size_t a);
+	void change_goal(std::size_t a, node_t goal);
+	void add_agent(Agent const& agent);
+	void block_edges(std::vector<edge_t> edges);
+
+	void check_agent(std::size_t a) const;
+	void check_node(node_t node) const;
+
+	Graph graph;
+	std::vector<Agent> agents;
+	// Replaced by an oracle of the new graph when edges are blocked, the mdds keep the tables they use
+	std::shared_ptr<DistanceOracle> oracle;
+	std::vector<MDD> mdds;
+	std::vector<bool> active;
+	// First time step of each agent, later than 0 for the agents added once the encoding exists
+	std::vector<std::size_t> arrivals;
+	std::vector<Variable> selectors;
+	std::vector<std::vector<node_t>> last_plan;
+	AtMostOneEncoding amo_encoding;
+	std::size_t max_makespan;
+
+	Glucose::SimpSolver solver;
+	SolverSink sink;
+	Context context;
+	std::size_t next_time_step = 0;
+	// Time step of the context at which the agents are on their initial node
+	std::size_t origin = 0;
+};
+
+} // namespace cpf
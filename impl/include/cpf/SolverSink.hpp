@@ -0,0 +1,28 @@
+#pragma once
+
+#include "ClauseSink.hpp"
+
+#include <glucose-syrup-4.1/simp/SimpSolver.h>
+
+namespace cpf {
+
+/*
+	Give the clauses directly to glucose, creating the solver's variables as needed
+*/
+class SolverSink : public ClauseSink {
+public:
+	SolverSink(Glucose::SimpSolver& solver_) noexcept;
+
+	void add_clause(Variable const* first, Variable const* last) override;
+
+	/*
+		Make sure the solver knows the variable, usually a selector not yet part of any clause
+	*/
+	Glucose::Lit to_lit(Variable const& var);
+
+private:
+	Glucose::SimpSolver* solver;
+	Glucose::vec<Glucose::Lit> buffer;
+};
+
+} // namespace cpf
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "ClauseArena.hpp"
+#include "Context.hpp"
+#include "Graph.hpp"
+#include "Interruption.hpp"
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace cpf {
+
+/*
+	Solve up to `window` makespans at once, by increasing makespan, each on its own thread with its own solver given the
+	clauses of the shared context. The context is only extended by the calling thread, before the solvers are loaded,
+	through `extend_up_to` which returns false when the makespan can't be solved.
+	A SAT makespan cancels the larger ones while the smaller ones keep running, and each finished makespan lets the next
+	one start: once nothing runs, the smallest SAT makespan is the optimal one
+	Return whether a makespan of `makespan_interval` is solvable, the smallest one being in `makespan` and its model in
+	`res`. The solvers are interrupted, and nothing new is started, once `interruption` is requested
+*/
+bool speculative_search(
+	Context& context,
+	ClauseArena const& arena,
+	std::function<bool(int)> const& extend_up_to,
+	std::pair<int, int> makespan_interval,
+	std::size_t window,
+	std::vector<std::vector<node_t>> const& hints,
+	Interruption& interruption,
+	int& makespan,
+	std::vector<bool>& res);
+
+} // namespace cpf
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Agent.hpp"
+#include "AtMostOne.hpp"
+#include "ClauseArena.hpp"
+#include "Context.hpp"
+#include "Graph.hpp"
+#include "Interruption.hpp"
+#include "LayeredMDD.hpp"
+#include "MakespanSolver.hpp"
+
+#include <vector>
+
+namespace cpf {
+
+/*
+	Lower the sum of costs of the plan in `res` without changing its makespan, the cost of an agent being the time at
+	which it reaches its goal for good. The number of unfinished time steps is counted by a totalizer, whose outputs are
+	assumed false one after the other on the same solver, until no cheaper plan exists or the solver is interrupted
+	Without `incremental_solver`, a solver is given the clauses of `arena` for this makespan, with `plan_paths` (the
+	paths of the plan in `res`) as phase hints
+	Return the sum of costs of the plan left in `res`
+*/
+std::size_t minimise_sum_of_costs(
+	Context& context,
+	Graph const& graph,
+	std::vector<Agent> const& agents,
+	std::vector<LayeredMDD> const& mdds,
+	std::size_t makespan,
+	IncrementalSolver* incremental_solver,
+	ClauseArena const& arena,
+	std::vector<std::vector<node_t>> const& plan_paths,
+	AtMostOneEncoding amo_encoding,
+	bool lazy_conflicts,
+	Interruption& interruption,
+	std::vector<bool>& res);
+
+} // namespace cpf
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cpf {
+
+/*
+	Fixed set of threads running the iterations of a parallel loop, the calling thread works as one of them
+*/
+class ThreadPool {
+public:
+	/*
+		`thread_count` includes the calling thread, so 1 (or 0) doesn't start any thread
+	*/
+	explicit ThreadPool(std::size_t thread_count);
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	std::size_t size() const noexcept;
+
+	/*
+		Call `task(i)` for each i in [0, count) in any order and on any thread, return once all of them are done
+		The first exception thrown by a task is rethrown here
+	*/
+	void run(std::size_t count, std::function<void(std::size_t)> const& task);
+
+private:
+	void work();
+	void work_on_current();
+
+	std::vector<std::thread> workers;
+
+	std::mutex mutex;
+	std::condition_variable wake_up;
+	std::condition_variable done;
+
+	// Current loop, workers start on it when `generation` changes
+	std::function<void(std::size_t)> const* current_task = nullptr;
+	std::size_t current_count							 = 0;
+	std::atomic<std::size_t> next_index{ 0 };
+	std::size_t busy_workers = 0;
+	std::size_t generation	 = 0;
+	std::exception_ptr error;
+	bool stopping = false;
+};
+
+} // namespace cpf
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Context.hpp"
+#include "Variable.hpp"
+
+#include <vector>
+
+namespace cpf {
+
+/*
+	Totalizer encoding (Bailleux and Boufkhad) counting the true variables of [first, last): the output i (from 0) is
+	true when at least i+1 inputs are true. Only this direction is encoded, which is enough to bound the count from
+	above by assuming the negation of an output.
+	At most `max_count` outputs are created, larger counts all imply the last one, which keeps the encoding in
+	O(n * max_count) clauses instead of O(n^2)
+*/
+std::vector<Variable> push_totalizer(
+	Context& context, Variable const* first, Variable const* last, std::size_t max_count);
+
+} // namespace cpf
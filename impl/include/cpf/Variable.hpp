@@ -10,7 +10,7 @@ constexpr int INVALID_VARIABLE_ID = -1;
 */
 class Variable {
 public:
-	constexpr Variable(int id_, bool negated_ = false) noexcept : id{ id_ }, negated{ negated_ } {}
+	constexpr Variable(int id_ = INVALID_VARIABLE_ID, bool negated_ = false) noexcept : id{ id_ }, negated{ negated_ } {}
 
 	constexpr Variable operator!() const noexcept { return Variable(id, !negated); }
 
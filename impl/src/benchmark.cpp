@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cpf/Agent.hpp>
+#include <cpf/BreadthFirstSearch.hpp>
+#include <cpf/CmdArg.hpp>
+#include <cpf/DistanceOracle.hpp>
+#include <cpf/FileSerializer.hpp>
+#include <cpf/Graph.hpp>
+#include <cpf/MDD.hpp>
+
+constexpr std::size_t SYNTHETIC_AGENTS	= 100;
+constexpr std::uint64_t SYNTHETIC_SEED = 42;
+
+void print_help(char const* prog_name) {
+	std::cerr << "Usage: " << prog_name << " <options> --input=<file>\n";
+	std::cerr << "       " << prog_name << " <options> --edges=<value>\n";
+	std::cerr << "\t--input=<file>   File in CPF format, whose agents are used for the measures [REQUIRED]\n";
+	std::cerr << "\t--edges=<value>  Instead of --input, a random graph of <value> edges (e.g. 1000000) between a "
+				 "quarter as many nodes, the same on each run, with " << SYNTHETIC_AGENTS << " agents\n";
+	std::cerr << "Options:\n";
+	std::cerr << "\t--repeat=<value> Times each measure is taken, the fastest one is printed [DEFAULT: 5]\n";
+}
+
+std::size_t get_repeat(cpf::CmdArgMap const& args) {
+	long o;
+	if (cpf::get_argument_as_long(args, "repeat", o)) {
+		return static_cast<std::size_t>(o < 1l ? 1l : o);
+	} else {
+		return 5;
+	}
+}
+
+/*
+	Fastest of `repeat` calls to `measure`, in milliseconds
+*/
+template<typename Measure>
+double fastest(std::size_t repeat, Measure measure) {
+	auto best = std::numeric_limits<double>::max();
+	for (std::size_t i = 0; i < repeat; ++i) {
+		auto begin = std::chrono::steady_clock::now();
+		measure();
+		std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - begin;
+		best											   = std::min(best, duration.count());
+	}
+	return best;
+}
+
+char const* mode_name(cpf::BreadthFirstSearch::Mode mode) {
+	return mode == cpf::BreadthFirstSearch::Mode::TopDown ? "top-down" : "direction-optimising";
+}
+
+/*
+	Construction of the mdds of the agents, as done before planning: one search per distinct goal, through a new
+	oracle each time. Then one search from each goal and each initial node, through the same search
+*/
+void benchmark_mdds(cpf::Graph const& graph, std::vector<cpf::Agent> const& agents, std::size_t repeat) {
+	std::set<cpf::node_t> goals;
+	for (auto const& agent : agents) { goals.insert(agent.goal); }
+	std::cout << "Graph of " << graph.size() << " nodes and " << graph.edge_count() << " edges, " << agents.size()
+			  << " agents going to " << goals.size() << " distinct goals\n";
+
+	std::vector<std::vector<std::uint32_t>> reference;
+	for (auto mode : { cpf::BreadthFirstSearch::Mode::TopDown, cpf::BreadthFirstSearch::Mode::DirectionOptimising }) {
+		auto mdds_time = fastest(repeat, [&]() {
+			cpf::DistanceOracle oracle(graph, std::numeric_limits<std::size_t>::max(), mode);
+			std::vector<cpf::MDD> mdds;
+			mdds.reserve(agents.size());
+			for (auto const& agent : agents) { mdds.emplace_back(oracle, agent); }
+		});
+		std::cout << "\tMdds of the agents, " << mode_name(mode) << ": " << mdds_time << "ms\n";
+
+		cpf::BreadthFirstSearch search(graph, mode);
+		std::vector<std::vector<std::uint32_t>> distances(2 * agents.size());
+		std::size_t bottom_up_levels = 0;
+
+		auto searches_time = fastest(repeat, [&]() {
+			bottom_up_levels = 0;
+			for (std::size_t a = 0; a < agents.size(); ++a) {
+				search.run(agents[a].initial, distances[2 * a]);
+				bottom_up_levels += search.bottom_up_levels();
+				search.run(agents[a].goal, distances[2 * a + 1]);
+				bottom_up_levels += search.bottom_up_levels();
+			}
+		});
+		std::cout << "\t" << distances.size() << " searches from the initial and goal nodes, " << mode_name(mode)
+				  << ": " << searches_time << "ms (" << bottom_up_levels << " levels expanded bottom-up)\n";
+
+		if (reference.empty()) {
+			reference = std::move(distances);
+		} else if (reference != distances) {
+			std::cout << "\tThe distances differ from the ones of " << mode_name(cpf::BreadthFirstSearch::Mode::TopDown)
+					  << '\n';
+		}
+	}
+}
+
+/*
+	Instance of --edges: random edges, a few of them duplicated or loops, and agents from the first nodes to the last
+	ones
+*/
+std::pair<cpf::Graph, std::vector<cpf::Agent>> synthetic_instance(std::size_t edge_count) {
+	auto node_count = std::max(2 * SYNTHETIC_AGENTS, edge_count / 4);
+	std::mt19937_64 eng(SYNTHETIC_SEED);
+	std::uniform_int_distribution<cpf::node_t> node(0, node_count - 1);
+
+	std::vector<cpf::edge_t> edges;
+	edges.reserve(edge_count);
+	for (std::size_t e = 0; e < edge_count; ++e) {
+		auto first = node(eng);
+		edges.emplace_back(first, node(eng));
+	}
+
+	std::vector<cpf::Agent> agents;
+	for (std::size_t a = 0; a < SYNTHETIC_AGENTS; ++a) { agents.push_back({ a, node_count - 1 - a }); }
+	return std::make_pair(cpf::Graph(node_count, std::move(edges)), std::move(agents));
+}
+
+/*
+	Parsing of the instance from memory, in the text and the binary formats, against a copy of the same bytes
+*/
+void benchmark_parsing(cpf::Graph const& graph, std::vector<cpf::Agent> const& agents, std::size_t repeat) {
+	std::ostringstream text_os;
+	cpf::serialize(text_os, graph, agents);
+	std::ostringstream binary_os;
+	cpf::serialize_binary(binary_os, graph, agents);
+
+	auto print = [](char const* what, std::size_t bytes, double milliseconds) {
+		std::cout << "\t" << what << ", " << bytes << " bytes: " << milliseconds << "ms ("
+				  << static_cast<double>(bytes) / (milliseconds * 1000.) << " MB/s)\n";
+	};
+
+	for (auto const& format : { std::make_pair("text", text_os.str()), std::make_pair("binary", binary_os.str()) }) {
+		auto const& bytes = format.second;
+		std::string copy(bytes.size(), '\0');
+		auto copy_time = fastest(repeat, [&]() { std::memcpy(&copy[0], bytes.data(), bytes.size()); });
+		print((std::string("Copy of the ") + format.first + " instance").c_str(), bytes.size(), copy_time);
+
+		bool same	   = true;
+		auto parse_time = fastest(repeat, [&]() {
+			auto parsed = cpf::deserialize(bytes.data(), bytes.size());
+			same		= parsed.first.edge_count() == graph.edge_count() && parsed.second.size() == agents.size();
+		});
+		print((std::string("Parsing of the ") + format.first + " instance").c_str(), bytes.size(), parse_time);
+		if (!same) {
+			std::cout << "\tThe instance parsed differs from the one written\n";
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	auto args = cpf::parse_args(argc, argv);
+
+	if (cpf::has_argument(args, "help")) {
+		print_help(argv[0]);
+		return 0;
+	}
+
+	std::pair<cpf::Graph, std::vector<cpf::Agent>> deserialized_data;
+	std::string input_filename;
+	long edge_count;
+	if (cpf::get_argument_as_long(args, "edges", edge_count)) {
+		deserialized_data = synthetic_instance(static_cast<std::size_t>(edge_count < 0l ? 0l : edge_count));
+	} else if (cpf::get_argument_as_string(args, "input", input_filename)) {
+		try {
+			deserialized_data = cpf::deserialize_file(input_filename);
+		} catch (std::exception const& e) {
+			std::cerr << e.what() << '\n';
+			return 2;
+		}
+	} else {
+		std::cerr << "Missing input file\n";
+		print_help(argv[0]);
+		return 3;
+	}
+	auto& graph	 = deserialized_data.first;
+	auto& agents = deserialized_data.second;
+
+	auto repeat = get_repeat(args);
+	benchmark_mdds(graph, agents, repeat);
+	benchmark_parsing(graph, agents, repeat);
+	return 0;
+}
@@ -0,0 +1,101 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cpf/Agent.hpp>
+#include <cpf/CmdArg.hpp>
+#include <cpf/FileSerializer.hpp>
+#include <cpf/Graph.hpp>
+
+void print_help(char const* prog_name) {
+	std::cerr << "Usage: " << prog_name << " <options> --input=<file>\n";
+	std::cerr << "\t--input=<file>    File in CPF format, text or binary [REQUIRED]\n";
+	std::cerr << "Options:\n";
+	std::cerr << "\t--output=<file>   File written to, otherwise write to standard output stream\n";
+	std::cerr << "\t--format=<value>  Format written: text or binary [DEFAULT: the other format than the input's]\n";
+}
+
+/*
+	Format of --format, or the other format than the one of `input_format`
+*/
+bool get_format(cpf::CmdArgMap const& args, cpf::FileFormat input_format, cpf::FileFormat& out) {
+	std::string o;
+	if (!cpf::get_argument_as_string(args, "format", o)) {
+		out = input_format == cpf::FileFormat::Text ? cpf::FileFormat::Binary : cpf::FileFormat::Text;
+		return true;
+	}
+
+	if (o == "text") {
+		out = cpf::FileFormat::Text;
+	} else if (o == "binary") {
+		out = cpf::FileFormat::Binary;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char** argv) {
+	auto args = cpf::parse_args(argc, argv);
+
+	if (cpf::has_argument(args, "help")) {
+		print_help(argv[0]);
+		return 0;
+	}
+
+	std::string input_filename;
+	if (!cpf::get_argument_as_string(args, "input", input_filename)) {
+		std::cerr << "Missing input file\n";
+		print_help(argv[0]);
+		return 3;
+	}
+
+	std::ifstream ifile(input_filename, std::ios::binary);
+	if (!ifile) {
+		std::cerr << "Unable to read file '" << input_filename << "'\n";
+		return 2;
+	}
+	auto input_format = cpf::detect_format(ifile);
+	ifile.close();
+
+	cpf::FileFormat output_format;
+	if (!get_format(args, input_format, output_format)) {
+		std::cerr << "Unknown format\n";
+		print_help(argv[0]);
+		return 3;
+	}
+
+	std::pair<cpf::Graph, std::vector<cpf::Agent>> deserialized_data;
+	try {
+		deserialized_data = cpf::deserialize_file(input_filename);
+	} catch (std::exception const& e) {
+		std::cerr << e.what() << '\n';
+		return 2;
+	}
+
+	std::ofstream ofile;
+	std::ostream* output_stream = &std::cout;
+	std::string output_filename;
+	if (cpf::get_argument_as_string(args, "output", output_filename)) {
+		ofile.open(output_filename, std::ios::binary);
+		if (!ofile) {
+			std::cerr << "Unable to write file '" << output_filename << "'\n";
+			return 2;
+		}
+		output_stream = &ofile;
+	}
+
+	if (output_format == cpf::FileFormat::Binary) {
+		cpf::serialize_binary(*output_stream, deserialized_data.first, deserialized_data.second);
+	} else {
+		cpf::serialize(*output_stream, deserialized_data.first, deserialized_data.second);
+	}
+
+	if (!output_stream->flush()) {
+		std::cerr << "Unable to write the instance\n";
+		return 2;
+	}
+	return 0;
+}
@@ -0,0 +1,132 @@
+#include <cpf/AtMostOne.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace cpf {
+
+/*
+	Under this size, the pairwise encoding is smaller or close enough to the others while propagating better
+*/
+constexpr std::size_t PAIRWISE_MAX_SIZE = 6;
+
+/*
+	Above this size, the auxiliary variables of the sequential counter outnumber the ones of the product encoding
+	enough to slow down the solver
+*/
+constexpr std::size_t SEQUENTIAL_MAX_SIZE = 128;
+
+constexpr std::size_t COMMANDER_GROUP_SIZE = 3;
+
+void push_pairwise(ClauseShard& shard, Variable const* first, Variable const* last) {
+	for (auto x = first; x != last; ++x) {
+		auto x0 = !*x;
+		for (auto y = x + 1; y != last; ++y) { shard.push(x0 | !*y); }
+	}
+}
+
+// s_i is true if one of x_1..x_i is true
+void push_sequential(ClauseShard& shard, Variable const* first, Variable const* last) {
+	auto n = static_cast<std::size_t>(last - first);
+	if (n <= 1)
+		return;
+
+	Variable previous = shard.create_aux_var();
+	shard.push(previous | !first[0]);
+	for (std::size_t i = 1; i + 1 < n; ++i) {
+		auto x			 = !first[i];
+		Variable current = shard.create_aux_var();
+		shard.push(x | current);
+		shard.push(current | !previous);
+		shard.push(x | !previous);
+		previous = current;
+	}
+	auto x = !first[n - 1];
+	shard.push(x | !previous);
+}
+
+void push_commander(ClauseShard& shard, Variable const* first, Variable const* last) {
+	auto n = static_cast<std::size_t>(last - first);
+	if (n <= PAIRWISE_MAX_SIZE) {
+		push_pairwise(shard, first, last);
+		return;
+	}
+
+	std::vector<Variable> commanders;
+	commanders.reserve((n + COMMANDER_GROUP_SIZE - 1) / COMMANDER_GROUP_SIZE);
+	for (auto group = first; group < last; group += COMMANDER_GROUP_SIZE) {
+		auto group_end = group + std::min<std::size_t>(COMMANDER_GROUP_SIZE, static_cast<std::size_t>(last - group));
+		auto commander = shard.create_aux_var();
+		push_pairwise(shard, group, group_end);
+		for (auto x = group; x != group_end; ++x) { shard.push(commander | !*x); }
+		commanders.push_back(commander);
+	}
+
+	push_commander(shard, commanders.data(), commanders.data() + commanders.size());
+}
+
+// x_k is placed at row k / columns_count and column k % columns_count
+void push_product(ClauseShard& shard, Variable const* first, Variable const* last) {
+	auto n = static_cast<std::size_t>(last - first);
+	if (n <= PAIRWISE_MAX_SIZE) {
+		push_pairwise(shard, first, last);
+		return;
+	}
+
+	auto columns_count = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(n))));
+	auto rows_count	   = (n + columns_count - 1) / columns_count;
+
+	std::vector<Variable> rows(rows_count);
+	std::vector<Variable> columns(columns_count);
+	for (auto& row : rows) { row = shard.create_aux_var(); }
+	for (auto& column : columns) { column = shard.create_aux_var(); }
+
+	for (std::size_t k = 0; k < n; ++k) {
+		shard.push(rows[k / columns_count] | !first[k]);
+		shard.push(columns[k % columns_count] | !first[k]);
+	}
+
+	push_product(shard, rows.data(), rows.data() + rows.size());
+	push_product(shard, columns.data(), columns.data() + columns.size());
+}
+
+bool parse_at_most_one_encoding(std::string const& name, AtMostOneEncoding& out) {
+	if (name == "pairwise") {
+		out = AtMostOneEncoding::Pairwise;
+	} else if (name == "sequential") {
+		out = AtMostOneEncoding::Sequential;
+	} else if (name == "commander") {
+		out = AtMostOneEncoding::Commander;
+	} else if (name == "product") {
+		out = AtMostOneEncoding::Product;
+	} else if (name == "auto") {
+		out = AtMostOneEncoding::Auto;
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
+void push_at_most_one(ClauseShard& shard, Variable const* first, Variable const* last, AtMostOneEncoding encoding) {
+	if (encoding == AtMostOneEncoding::Auto) {
+		auto n = static_cast<std::size_t>(last - first);
+		if (n <= PAIRWISE_MAX_SIZE) {
+			encoding = AtMostOneEncoding::Pairwise;
+		} else if (n <= SEQUENTIAL_MAX_SIZE) {
+			encoding = AtMostOneEncoding::Sequential;
+		} else {
+			encoding = AtMostOneEncoding::Product;
+		}
+	}
+
+	switch (encoding) {
+		case AtMostOneEncoding::Pairwise: push_pairwise(shard, first, last); break;
+		case AtMostOneEncoding::Sequential: push_sequential(shard, first, last); break;
+		case AtMostOneEncoding::Commander: push_commander(shard, first, last); break;
+		case AtMostOneEncoding::Product: push_product(shard, first, last); break;
+		case AtMostOneEncoding::Auto: break;
+	}
+}
+
+} // namespace cpf
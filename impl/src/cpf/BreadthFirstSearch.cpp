@@ -0,0 +1,105 @@
+#include <cpf/BreadthFirstSearch.hpp>
+
+#include <utility>
+
+namespace cpf {
+
+namespace {
+
+// Bottom-up once the growing frontier has more than 1/ALPHA of the edges left to visit, top-down again once the
+// frontier has less than 1/BETA of the nodes. The values of Beamer et al.
+constexpr std::size_t ALPHA = 14;
+constexpr std::size_t BETA	= 24;
+
+constexpr std::size_t WORD_BITS = 64;
+
+} // namespace
+
+BreadthFirstSearch::BreadthFirstSearch(Graph const& graph_, Mode mode_)
+	: graph{ &graph_ }
+	, mode{ mode_ } {
+	frontier.reserve(graph_.size());
+	next_frontier.reserve(graph_.size());
+	if (mode == Mode::DirectionOptimising) {
+		in_frontier.assign((graph_.size() + WORD_BITS - 1) / WORD_BITS, 0);
+	}
+	for (node_t v = 0; v < graph_.size(); ++v) { degree_sum += graph_.neighbours_of(v).size(); }
+}
+
+void BreadthFirstSearch::run(node_t source, std::vector<std::uint32_t>& distances) {
+	distances.assign(graph->size(), UNREACHABLE_DISTANCE);
+	frontier.clear();
+	next_frontier.clear();
+	bottom_up_count = 0;
+
+	distances[source] = 0;
+	frontier.push_back(source);
+	frontier_edges	= graph->neighbours_of(source).size();
+	unvisited_edges = degree_sum - frontier_edges;
+
+	bool bottom_up				= false;
+	std::size_t previous_size	= 0;
+	for (std::uint32_t distance = 1; !frontier.empty(); ++distance) {
+		if (mode == Mode::DirectionOptimising) {
+			// A bottom-up level reads the whole graph, it's never worth it for a small frontier
+			auto large = frontier.size() * BETA > graph->size();
+			auto heavy = frontier.size() > previous_size && frontier_edges * ALPHA > unvisited_edges;
+			bottom_up  = large && (bottom_up || heavy);
+		}
+		previous_size = frontier.size();
+
+		frontier_edges = 0;
+		if (bottom_up) {
+			bottom_up_level(distances, distance);
+			++bottom_up_count;
+		} else {
+			top_down_level(distances, distance);
+		}
+		std::swap(frontier, next_frontier);
+		next_frontier.clear();
+	}
+}
+
+std::size_t BreadthFirstSearch::bottom_up_levels() const noexcept {
+	return bottom_up_count;
+}
+
+void BreadthFirstSearch::top_down_level(std::vector<std::uint32_t>& distances, std::uint32_t distance) {
+	for (auto node : frontier) {
+		for (auto neighbour : graph->neighbours_of(node)) {
+			if (distances[neighbour] == UNREACHABLE_DISTANCE) {
+				distances[neighbour] = distance;
+				next_frontier.push_back(neighbour);
+
+				auto degree = graph->neighbours_of(neighbour).size();
+				frontier_edges += degree;
+				unvisited_edges -= degree;
+			}
+		}
+	}
+}
+
+void BreadthFirstSearch::bottom_up_level(std::vector<std::uint32_t>& distances, std::uint32_t distance) {
+	for (auto node : frontier) { in_frontier[node / WORD_BITS] |= std::uint64_t{ 1 } << (node % WORD_BITS); }
+
+	for (node_t node = 0; node < graph->size(); ++node) {
+		if (distances[node] != UNREACHABLE_DISTANCE)
+			continue;
+
+		auto neighbours = graph->neighbours_of(node);
+		for (auto neighbour : neighbours) {
+			if (in_frontier[neighbour / WORD_BITS] & (std::uint64_t{ 1 } << (neighbour % WORD_BITS))) {
+				distances[node] = distance;
+				next_frontier.push_back(node);
+				frontier_edges += neighbours.size();
+				unvisited_edges -= neighbours.size();
+				break;
+			}
+		}
+	}
+
+	// Only the words of the frontier were set
+	for (auto node : frontier) { in_frontier[node / WORD_BITS] = 0; }
+}
+
+} // namespace cpf
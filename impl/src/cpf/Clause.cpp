@@ -2,23 +2,59 @@
 
 namespace cpf {
 
-Clause::Clause(Variable const& v) : variables{ v } {}
+constexpr std::size_t Clause::INLINE_CAPACITY;
 
-Clause::Clause(std::initializer_list<Variable> variables_) : variables{ variables_ } {}
+Clause::Clause(Variable const& v) {
+	push(v);
+}
+
+Clause::Clause(std::initializer_list<Variable> variables_) {
+	for (auto const& v : variables_) { push(v); }
+}
+
+Clause& Clause::push(Variable const& v) {
+	if (count < INLINE_CAPACITY) {
+		inline_variables[count] = v;
+	} else {
+		if (count == INLINE_CAPACITY) {
+			spilled_variables.assign(std::begin(inline_variables), std::end(inline_variables));
+		}
+		spilled_variables.push_back(v);
+	}
+
+	++count;
+	return *this;
+}
+
+void Clause::clear() noexcept {
+	spilled_variables.clear();
+	count = 0;
+}
+
+Variable const* Clause::begin() const noexcept {
+	return count > INLINE_CAPACITY ? spilled_variables.data() : inline_variables.data();
+}
+
+Variable const* Clause::end() const noexcept {
+	return begin() + count;
+}
+
+std::size_t Clause::size() const noexcept {
+	return count;
+}
 
 Clause operator|(Variable const& lhs, Variable const& rhs) {
 	return { lhs, rhs };
 }
 
 Clause& operator|=(Clause& lhs, Variable const& rhs) {
-	lhs.variables.emplace_back(rhs);
-	return lhs;
+	return lhs.push(rhs);
 }
 
 Clause&& operator|(Clause&& lhs, Variable const& rhs) {
-	lhs.variables.emplace_back(rhs);
+	lhs.push(rhs);
 	return std::move(lhs);
 }
 
 
-} // namespace cpf
\ No newline at end of file
+} // namespace cpf
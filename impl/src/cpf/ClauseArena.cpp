@@ -0,0 +1,32 @@
+#include <cpf/ClauseArena.hpp>
+
+namespace cpf {
+
+ClauseArena::ClauseArena() : offsets{ 0 } {}
+
+void ClauseArena::add_clause(Variable const* first, Variable const* last) {
+	variables.insert(std::end(variables), first, last);
+	offsets.push_back(variables.size());
+}
+
+std::size_t ClauseArena::size() const noexcept {
+	return offsets.size() - 1;
+}
+
+ClauseArena::ClauseView ClauseArena::operator[](std::size_t index) const noexcept {
+	return { variables.data() + offsets[index], variables.data() + offsets[index + 1] };
+}
+
+void ClauseArena::replay(ClauseSink& sink, std::size_t first_clause) const {
+	for (std::size_t i = first_clause; i < size(); ++i) {
+		auto clause = (*this)[i];
+		sink.add_clause(clause.begin(), clause.end());
+	}
+}
+
+void ClauseArena::clear() noexcept {
+	variables.clear();
+	offsets.resize(1);
+}
+
+} // namespace cpf
@@ -0,0 +1,35 @@
+#include <cpf/ClauseShard.hpp>
+
+namespace cpf {
+
+constexpr int FIRST_AUX_ID = INVALID_VARIABLE_ID - 1;
+
+Variable ClauseShard::create_aux_var() noexcept {
+	return Variable(FIRST_AUX_ID - auxiliaries++);
+}
+
+ClauseShard& ClauseShard::push(Clause const& clause) {
+	arena.add_clause(clause.begin(), clause.end());
+	return *this;
+}
+
+Variable ClauseShard::resolve(Variable var, int aux_base) noexcept {
+	if (var.id > INVALID_VARIABLE_ID)
+		return var;
+	return Variable(aux_base + (FIRST_AUX_ID - var.id), var.negated);
+}
+
+ClauseArena const& ClauseShard::clauses() const noexcept {
+	return arena;
+}
+
+int ClauseShard::aux_count() const noexcept {
+	return auxiliaries;
+}
+
+void ClauseShard::clear() noexcept {
+	arena.clear();
+	auxiliaries = 0;
+}
+
+} // namespace cpf
@@ -2,49 +2,164 @@
 
 namespace cpf {
 
-Context::Context(std::size_t makespan, std::size_t agent_count_, std::size_t node_count_)
-	: variables(agent_count_ * node_count_ * (makespan + 1), INVALID_VARIABLE_ID)
+Context::Context(std::size_t makespan, std::size_t agent_count_, std::size_t node_count_, ClauseSink& sink_)
+	: layers(agent_count_ * (makespan + 1))
+	, occupancies(makespan + 1)
 	, agent_count{ agent_count_ }
-	, node_count{ node_count_ } {}
+	, node_count{ node_count_ }
+	, sink{ &sink_ } {}
 
-Variable Context::create_var(std::size_t time, std::size_t agent_id, node_t node) noexcept {
-	auto index = node + agent_id * node_count + time * (node_count * agent_count);
-	if (variables[index] == INVALID_VARIABLE_ID) {
-		variables[index] = next_variable_id++;
+void Context::extend(std::size_t makespan) {
+	// Time is the outermost dimension, growing the makespan only append new time steps
+	layers.resize(agent_count * (makespan + 1));
+	occupancies.resize(makespan + 1);
+}
+
+std::size_t Context::add_agent() {
+	auto time_steps = occupancies.size();
+	std::vector<Layer> grown((agent_count + 1) * time_steps);
+	for (std::size_t t = 0; t < time_steps; ++t) {
+		for (std::size_t a = 0; a < agent_count; ++a) {
+			grown[a + t * (agent_count + 1)] = std::move(layers[a + t * agent_count]);
+		}
 	}
-	return Variable(variables[index]);
+	layers = std::move(grown);
+	return agent_count++;
+}
+
+std::size_t Context::time_steps_count() const noexcept {
+	return occupancies.size();
+}
+
+Variable Context::create_var(std::size_t time, std::size_t agent_id, node_t node) {
+	assert(node < node_count);
+	auto& l	 = layers[agent_id + time * agent_count];
+	auto it	 = std::lower_bound(std::begin(l.nodes), std::end(l.nodes), node);
+	auto idx = it - std::begin(l.nodes);
+	if (it == std::end(l.nodes) || *it != node) {
+		// Variables are mostly created by increasing node, which only append to the layer
+		l.nodes.insert(it, node);
+		l.variables.insert(std::begin(l.variables) + idx, next_variable_id++);
+	}
+	return Variable(l.variables[idx]);
 }
 
 Variable Context::get_var(std::size_t time, std::size_t agent_id, node_t node) const noexcept {
 	assert(contains(time, agent_id, node));
-	auto index = node + agent_id * node_count + time * (node_count * agent_count);
-	return Variable(variables[index]);
+	return Variable(find(time, agent_id, node));
 }
 
 bool Context::contains(std::size_t time, std::size_t agent_id, node_t node) const noexcept {
-	auto index = node + agent_id * node_count + time * (node_count * agent_count);
-	return variables[index] != INVALID_VARIABLE_ID;
+	return find(time, agent_id, node) != INVALID_VARIABLE_ID;
 }
 
-Context& Context::push(Clause clause) {
-	clauses.emplace_back(std::move(clause));
-	return *this;
+Variable Context::get_var_at(std::size_t time, std::size_t agent_id, std::size_t index) const noexcept {
+	return Variable(layer(time, agent_id).variables[index]);
 }
 
-std::size_t Context::variables_count() const noexcept {
-	return next_variable_id;
+std::vector<node_t> const& Context::nodes_at(std::size_t time, std::size_t agent_id) const noexcept {
+	return layer(time, agent_id).nodes;
 }
 
-std::size_t Context::clauses_count() const noexcept {
-	return clauses.size();
+void Context::index_agents(std::size_t time) {
+	std::vector<std::pair<node_t, std::size_t>> nodes_agents;
+	for (std::size_t a = 0; a < agent_count; ++a) {
+		for (auto v : nodes_at(time, a)) { nodes_agents.emplace_back(v, a); }
+	}
+	std::sort(std::begin(nodes_agents), std::end(nodes_agents));
+
+	auto& occupancy = occupancies[time];
+	occupancy.nodes.clear();
+	occupancy.offsets.clear();
+	occupancy.agents.clear();
+	occupancy.agents.reserve(nodes_agents.size());
+
+	for (auto const& node_agent : nodes_agents) {
+		if (occupancy.nodes.empty() || occupancy.nodes.back() != node_agent.first) {
+			occupancy.nodes.push_back(node_agent.first);
+			occupancy.offsets.push_back(occupancy.agents.size());
+		}
+		occupancy.agents.push_back(node_agent.second);
+	}
+	occupancy.offsets.push_back(occupancy.agents.size());
+}
+
+std::vector<node_t> const& Context::occupied_nodes(std::size_t time) const noexcept {
+	return occupancies[time].nodes;
+}
+
+Range<std::size_t> Context::agents_at(std::size_t time, node_t node) const noexcept {
+	auto const& occupancy = occupancies[time];
+	auto it				  = std::lower_bound(std::begin(occupancy.nodes), std::end(occupancy.nodes), node);
+	if (it == std::end(occupancy.nodes) || *it != node) {
+		return { nullptr, nullptr };
+	}
+
+	auto idx = static_cast<std::size_t>(it - std::begin(occupancy.nodes));
+	return { occupancy.agents.data() + occupancy.offsets[idx], occupancy.agents.data() + occupancy.offsets[idx + 1] };
+}
+
+Context::Layer const& Context::layer(std::size_t time, std::size_t agent_id) const noexcept {
+	return layers[agent_id + time * agent_count];
+}
+
+int Context::find(std::size_t time, std::size_t agent_id, node_t node) const noexcept {
+	auto const& l = layer(time, agent_id);
+	auto it		  = std::lower_bound(std::begin(l.nodes), std::end(l.nodes), node);
+	if (it == std::end(l.nodes) || *it != node) {
+		return INVALID_VARIABLE_ID;
+	}
+	return l.variables[static_cast<std::size_t>(it - std::begin(l.nodes))];
+}
+
+Variable Context::create_aux_var() noexcept {
+	return Variable(next_variable_id++);
+}
+
+Variable Context::makespan_bound(std::size_t k) {
+	while (bounds.size() <= k) {
+		auto bound = create_aux_var();
+		if (!bounds.empty()) {
+			auto previous = !bounds.back();
+			push(previous | bound);
+		}
+		bounds.push_back(bound);
+	}
+	return bounds[k];
+}
+
+std::size_t Context::makespan_bounds_count() const noexcept {
+	return bounds.size();
 }
 
-std::vector<Clause>::const_iterator Context::begin() const noexcept {
-	return std::begin(clauses);
+Context& Context::push(Clause const& clause) {
+	assert(sink);
+	sink->add_clause(clause.begin(), clause.end());
+	++clauses;
+	return *this;
+}
+
+Context& Context::merge(ClauseShard const& shard) {
+	assert(sink);
+	auto aux_base = next_variable_id;
+	next_variable_id += shard.aux_count();
+
+	auto const& arena = shard.clauses();
+	for (std::size_t i = 0; i < arena.size(); ++i) {
+		merge_buffer.clear();
+		for (auto var : arena[i]) { merge_buffer.push_back(ClauseShard::resolve(var, aux_base)); }
+		sink->add_clause(merge_buffer.data(), merge_buffer.data() + merge_buffer.size());
+	}
+	clauses += arena.size();
+	return *this;
 }
 
-std::vector<Clause>::const_iterator Context::end() const noexcept {
-	return std::end(clauses);
+std::size_t Context::variables_count() const noexcept {
+	return next_variable_id;
+}
+
+std::size_t Context::clauses_count() const noexcept {
+	return clauses;
 }
 
 } // namespace cpf
\ No newline at end of file
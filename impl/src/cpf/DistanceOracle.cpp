@@ -0,0 +1,189 @@
+#include <cpf/DistanceOracle.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace cpf {
+
+namespace {
+
+constexpr char MAGIC[8] = { 'C', 'P', 'F', 'D', 'I', 'S', 'T', '2' };
+
+void write_u64(std::ostream& os, std::uint64_t value) {
+	os.write(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+bool read_u64(std::istream& is, std::uint64_t& value) {
+	return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+} // namespace
+
+constexpr std::uint16_t DistanceTable::SHORT_UNREACHABLE;
+
+DistanceTable::DistanceTable(BreadthFirstSearch& search, std::vector<std::uint32_t>& buffer, node_t source_)
+	: source_node{ source_ } {
+	search.run(source_, buffer);
+
+	std::uint32_t farthest = 0;
+	for (auto distance : buffer) {
+		if (distance != UNREACHABLE_DISTANCE)
+			farthest = std::max(farthest, distance);
+	}
+	if (farthest >= SHORT_UNREACHABLE) {
+		distances = buffer;
+		return;
+	}
+
+	short_distances.resize(buffer.size());
+	for (std::size_t v = 0; v < buffer.size(); ++v) {
+		short_distances[v] = buffer[v] == UNREACHABLE_DISTANCE ? SHORT_UNREACHABLE
+															   : static_cast<std::uint16_t>(buffer[v]);
+	}
+}
+
+node_t DistanceTable::source() const noexcept {
+	return source_node;
+}
+
+std::size_t DistanceTable::operator[](node_t node) const noexcept {
+	if (!short_distances.empty()) {
+		auto distance = short_distances[node];
+		return distance == SHORT_UNREACHABLE ? std::numeric_limits<std::size_t>::max() : distance;
+	}
+	auto distance = distances[node];
+	return distance == UNREACHABLE_DISTANCE ? std::numeric_limits<std::size_t>::max() : distance;
+}
+
+std::size_t DistanceTable::distance_size() const noexcept {
+	return short_distances.empty() ? sizeof(std::uint32_t) : sizeof(std::uint16_t);
+}
+
+DistanceOracle::Search::Search(Graph const& graph, BreadthFirstSearch::Mode mode) : bfs(graph, mode) {}
+
+DistanceOracle::DistanceOracle(Graph const& graph_, std::size_t max_tables_, BreadthFirstSearch::Mode mode_)
+	: graph_ptr{ &graph_ }
+	, graph_hash{ hash_graph(graph_) }
+	, max_tables{ max_tables_ }
+	, mode{ mode_ }
+	, tables(graph_.size()) {}
+
+Graph const& DistanceOracle::graph() const noexcept {
+	return *graph_ptr;
+}
+
+std::shared_ptr<DistanceTable const> DistanceOracle::distances_from(node_t source) {
+	std::unique_ptr<Search> search;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (tables[source])
+			return tables[source];
+		if (!idle_searches.empty()) {
+			search = std::move(idle_searches.back());
+			idle_searches.pop_back();
+		}
+	}
+	if (!search) {
+		search.reset(new Search(*graph_ptr, mode));
+	}
+
+	// Computed without the lock, another thread may compute the same table meanwhile and the first one is kept
+	auto table = std::make_shared<DistanceTable const>(search->bfs, search->buffer, source);
+	std::lock_guard<std::mutex> lock(mutex);
+	idle_searches.push_back(std::move(search));
+	if (tables[source])
+		return tables[source];
+	insert(table);
+	return table;
+}
+
+void DistanceOracle::compute_all(ThreadPool& pool) {
+	pool.run(graph_ptr->size(), [this](std::size_t source) { distances_from(source); });
+}
+
+std::size_t DistanceOracle::table_count() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return tables_count;
+}
+
+void DistanceOracle::save(std::ostream& os) const {
+	std::lock_guard<std::mutex> lock(mutex);
+	os.write(MAGIC, sizeof(MAGIC));
+	write_u64(os, graph_hash);
+	write_u64(os, graph_ptr->size());
+	write_u64(os, tables_count);
+	for (auto const& table : tables) {
+		if (!table)
+			continue;
+		write_u64(os, table->source_node);
+		write_u64(os, table->distance_size());
+		if (table->short_distances.empty()) {
+			os.write(
+				reinterpret_cast<char const*>(table->distances.data()),
+				static_cast<std::streamsize>(table->distances.size() * sizeof(std::uint32_t)));
+		} else {
+			os.write(
+				reinterpret_cast<char const*>(table->short_distances.data()),
+				static_cast<std::streamsize>(table->short_distances.size() * sizeof(std::uint16_t)));
+		}
+	}
+}
+
+bool DistanceOracle::load(std::istream& is) {
+	char magic[sizeof(MAGIC)];
+	std::uint64_t hash		 = 0;
+	std::uint64_t node_count = 0;
+	std::uint64_t count		 = 0;
+	if (!is.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+		return false;
+	if (!read_u64(is, hash) || !read_u64(is, node_count) || !read_u64(is, count))
+		return false;
+	if (hash != graph_hash || node_count != graph_ptr->size() || count > node_count)
+		return false;
+
+	// Everything is read before any table is kept, a truncated file is ignored as a whole
+	std::vector<std::shared_ptr<DistanceTable const>> read_tables;
+	read_tables.reserve(count);
+	for (std::uint64_t i = 0; i < count; ++i) {
+		std::uint64_t source		= 0;
+		std::uint64_t distance_size = 0;
+		if (!read_u64(is, source) || source >= node_count || !read_u64(is, distance_size))
+			return false;
+
+		auto table		   = std::shared_ptr<DistanceTable>(new DistanceTable());
+		table->source_node = source;
+		char* data;
+		if (distance_size == sizeof(std::uint16_t)) {
+			table->short_distances.resize(node_count);
+			data = reinterpret_cast<char*>(table->short_distances.data());
+		} else if (distance_size == sizeof(std::uint32_t)) {
+			table->distances.resize(node_count);
+			data = reinterpret_cast<char*>(table->distances.data());
+		} else {
+			return false;
+		}
+		if (!is.read(data, static_cast<std::streamsize>(node_count * distance_size)))
+			return false;
+		read_tables.push_back(std::move(table));
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto& table : read_tables) {
+		if (!tables[table->source_node]) {
+			insert(std::move(table));
+		}
+	}
+	return true;
+}
+
+void DistanceOracle::insert(std::shared_ptr<DistanceTable const> table) {
+	if (tables_count >= max_tables) {
+		for (auto& t : tables) { t.reset(); }
+		tables_count = 0;
+	}
+	auto source	   = table->source_node;
+	tables[source] = std::move(table);
+	++tables_count;
+}
+
+} // namespace cpf
@@ -0,0 +1,167 @@
+#include <cpf/Encoding.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace cpf {
+
+namespace {
+
+/*
+	Agents present in both sorted ranges, i.e. on `from` at t and on `to` at t+1
+*/
+void intersect_agents(Range<std::size_t> lhs, Range<std::size_t> rhs, std::vector<std::size_t>& out) {
+	out.clear();
+	std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(out));
+}
+
+} // namespace
+
+void push_movement_clauses(
+	Context const& context,
+	ClauseShard& shard,
+	Graph const& graph,
+	std::size_t t,
+	std::size_t a_begin,
+	std::size_t a_end) {
+	for (std::size_t a = a_begin; a < a_end; ++a) {
+		for (auto v : context.nodes_at(t, a)) {
+			auto x0		  = !context.get_var(t, a, v);
+			Clause clause = x0;
+			if (context.contains(t + 1, a, v)) {
+				clause |= context.get_var(t + 1, a, v);
+			}
+			for (auto u : graph.neighbours_of(v)) {
+				if (u != v && context.contains(t + 1, a, u)) {
+					clause |= context.get_var(t + 1, a, u);
+				}
+			}
+			shard.push(clause);
+		}
+	}
+}
+
+void push_mdd_movement_clauses(
+	Context const& context,
+	ClauseShard& shard,
+	std::vector<LayeredMDD> const& mdds,
+	std::size_t t,
+	std::size_t a_begin,
+	std::size_t a_end) {
+	for (std::size_t a = a_begin; a < a_end; ++a) {
+		auto const& nodes = mdds[a].layer(t);
+		assert(nodes.size() == context.nodes_at(t, a).size());
+		for (std::size_t i = 0; i < nodes.size(); ++i) {
+			auto x0		  = !context.get_var_at(t, a, i);
+			Clause clause = x0;
+			for (auto s : mdds[a].successors(t, i)) { clause |= context.get_var_at(t + 1, a, s); }
+			shard.push(clause);
+		}
+	}
+}
+
+void push_vertex_conflict_clauses(
+	Context const& context,
+	ClauseShard& shard,
+	std::size_t t,
+	std::size_t first,
+	std::size_t last,
+	AtMostOneEncoding encoding) {
+	std::vector<Variable> variables;
+	auto const& nodes = context.occupied_nodes(t);
+	for (auto i = first; i < last; ++i) {
+		auto v		= nodes[i];
+		auto agents = context.agents_at(t, v);
+		if (agents.size() < 2)
+			continue;
+
+		variables.clear();
+		for (auto a : agents) { variables.push_back(context.get_var(t, a, v)); }
+		push_at_most_one(shard, variables.data(), variables.data() + variables.size(), encoding);
+	}
+}
+
+void push_single_position_clauses(
+	Context const& context,
+	ClauseShard& shard,
+	std::size_t t,
+	std::size_t a_begin,
+	std::size_t a_end,
+	AtMostOneEncoding encoding) {
+	std::vector<Variable> variables;
+	for (std::size_t a = a_begin; a < a_end; ++a) {
+		variables.clear();
+		for (auto v : context.nodes_at(t, a)) { variables.push_back(context.get_var(t, a, v)); }
+		push_at_most_one(shard, variables.data(), variables.data() + variables.size(), encoding);
+	}
+}
+
+void push_swap_conflict_clauses(
+	Context const& context,
+	ClauseShard& shard,
+	Graph const& graph,
+	std::size_t t,
+	std::size_t first,
+	std::size_t last) {
+	std::vector<std::size_t> agents_forward;
+	std::vector<std::size_t> agents_backward;
+	auto const& nodes = context.occupied_nodes(t);
+	for (auto i = first; i < last; ++i) {
+		auto v = nodes[i];
+		for (auto u : graph.neighbours_of(v)) {
+			if (u <= v)
+				continue;
+
+			intersect_agents(context.agents_at(t, v), context.agents_at(t + 1, u), agents_forward);
+			if (agents_forward.empty())
+				continue;
+
+			intersect_agents(context.agents_at(t, u), context.agents_at(t + 1, v), agents_backward);
+			for (auto a : agents_forward) {
+				for (auto b : agents_backward) {
+					if (a == b)
+						continue;
+
+					auto x0 = !context.get_var(t, a, v);
+					auto x1 = !context.get_var(t + 1, a, u);
+					auto x2 = !context.get_var(t, b, u);
+					auto x3 = !context.get_var(t + 1, b, v);
+					shard.push(x0 | x1 | x2 | x3);
+				}
+			}
+		}
+	}
+}
+
+void push_agent_conflict_clauses(
+	Context const& context, ClauseShard& shard, Graph const& graph, std::size_t t, std::size_t a) {
+	std::vector<std::size_t> agents_backward;
+	for (auto v : context.nodes_at(t, a)) {
+		auto x = !context.get_var(t, a, v);
+		for (auto b : context.agents_at(t, v)) {
+			if (b != a) {
+				shard.push(x | !context.get_var(t, b, v));
+			}
+		}
+
+		if (t + 1 >= context.time_steps_count())
+			continue;
+
+		// a moving from v to u while b moves from u to v
+		for (auto u : graph.neighbours_of(v)) {
+			if (u == v || !context.contains(t + 1, a, u))
+				continue;
+
+			intersect_agents(context.agents_at(t, u), context.agents_at(t + 1, v), agents_backward);
+			auto y = !context.get_var(t + 1, a, u);
+			for (auto b : agents_backward) {
+				if (b != a) {
+					shard.push(x | y | !context.get_var(t, b, u) | !context.get_var(t + 1, b, v));
+				}
+			}
+		}
+	}
+}
+
+} // namespace cpf
@@ -0,0 +1,157 @@
+#include <cpf/Feasibility.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace cpf {
+
+namespace {
+
+constexpr std::size_t NO_AGENT = std::numeric_limits<std::size_t>::max();
+
+struct Component {
+	std::size_t nodes		= 0;
+	std::size_t degrees		= 0;
+	std::size_t agents		= 0;
+	std::size_t max_degree	= 0;
+	node_t end				= INVALID_NODE; // Node of degree 1 or less, only used for the paths
+	bool all_on_their_goals = true;
+};
+
+std::size_t degree(Graph const& graph, node_t node) noexcept {
+	auto neighbours = graph.neighbours_of(node);
+	return static_cast<std::size_t>(std::count_if(
+		neighbours.begin(), neighbours.end(), [node](node_t neighbour) { return neighbour != node; }));
+}
+
+/*
+	Label the connected components with breadth first searches, `component_of` is indexed by node
+*/
+std::vector<Component> label_components(Graph const& graph, std::vector<std::size_t>& component_of) {
+	std::vector<Component> components;
+	component_of.assign(graph.size(), NO_AGENT);
+
+	std::vector<node_t> queue;
+	for (node_t root = 0; root < graph.size(); ++root) {
+		if (component_of[root] != NO_AGENT)
+			continue;
+
+		Component component;
+		component_of[root] = components.size();
+		queue.assign(1, root);
+		for (std::size_t i = 0; i < queue.size(); ++i) {
+			auto node = queue[i];
+			auto d	  = degree(graph, node);
+			component.nodes += 1;
+			component.degrees += d;
+			component.max_degree = std::max(component.max_degree, d);
+			if (d <= 1) {
+				component.end = node;
+			}
+
+			for (auto neighbour : graph.neighbours_of(node)) {
+				if (component_of[neighbour] == NO_AGENT) {
+					component_of[neighbour] = components.size();
+					queue.push_back(neighbour);
+				}
+			}
+		}
+		components.push_back(component);
+	}
+	return components;
+}
+
+/*
+	Position of each node along the path starting at `end`
+*/
+void index_path(Graph const& graph, node_t end, std::vector<std::size_t>& position) {
+	auto previous = INVALID_NODE;
+	auto node	  = end;
+	for (std::size_t i = 0; node != INVALID_NODE; ++i) {
+		position[node] = i;
+		auto next	   = INVALID_NODE;
+		for (auto neighbour : graph.neighbours_of(node)) {
+			if (neighbour != node && neighbour != previous) {
+				next = neighbour;
+			}
+		}
+		previous = node;
+		node	 = next;
+	}
+}
+
+} // namespace
+
+std::string find_infeasibility(Graph const& graph, std::vector<Agent> const& agents) {
+	std::vector<std::size_t> initial_of(graph.size(), NO_AGENT);
+	std::vector<std::size_t> goal_of(graph.size(), NO_AGENT);
+	for (std::size_t a = 0; a < agents.size(); ++a) {
+		auto initial = agents[a].initial;
+		auto goal	 = agents[a].goal;
+		if (initial >= graph.size() || goal >= graph.size())
+			return "Agent #" + std::to_string(a) + " starts or ends outside of the graph";
+		if (initial_of[initial] != NO_AGENT)
+			return "Agents #" + std::to_string(initial_of[initial]) + " and #" + std::to_string(a)
+				   + " start on the same node";
+		if (goal_of[goal] != NO_AGENT)
+			return "Agents #" + std::to_string(goal_of[goal]) + " and #" + std::to_string(a) + " end on the same node";
+		initial_of[initial] = a;
+		goal_of[goal]		= a;
+	}
+
+	std::vector<std::size_t> component_of;
+	auto components = label_components(graph, component_of);
+	for (std::size_t a = 0; a < agents.size(); ++a) {
+		auto& component = components[component_of[agents[a].initial]];
+		if (component_of[agents[a].goal] != component_of[agents[a].initial])
+			return "Agent #" + std::to_string(a) + " can't reach its goal";
+
+		component.agents += 1;
+		component.all_on_their_goals &= agents[a].initial == agents[a].goal;
+	}
+
+	std::vector<std::size_t> position(graph.size(), NO_AGENT);
+	for (std::size_t c = 0; c < components.size(); ++c) {
+		auto const& component = components[c];
+		bool is_tree		  = component.degrees / 2 + 1 == component.nodes;
+		if (!is_tree || component.all_on_their_goals)
+			continue;
+
+		// Each move needs a free node, or a cycle to rotate the agents along it
+		if (component.agents == component.nodes)
+			return "The agents fill a part of the graph without cycle, none of them can move";
+
+		if (component.max_degree <= 2) {
+			index_path(graph, component.end, position);
+		}
+	}
+
+	// Order of the initial and of the goal nodes of the agents on the paths
+	std::vector<std::pair<std::size_t, std::size_t>> by_initial;
+	std::vector<std::pair<std::size_t, std::size_t>> by_goal;
+	for (std::size_t a = 0; a < agents.size(); ++a) {
+		if (position[agents[a].initial] == NO_AGENT)
+			continue;
+		by_initial.emplace_back(component_of[agents[a].initial], position[agents[a].initial]);
+		by_goal.emplace_back(component_of[agents[a].goal], position[agents[a].goal]);
+	}
+
+	std::vector<std::size_t> initial_order(by_initial.size());
+	std::vector<std::size_t> goal_order(by_goal.size());
+	for (std::size_t i = 0; i < initial_order.size(); ++i) {
+		initial_order[i] = i;
+		goal_order[i]	 = i;
+	}
+	std::sort(initial_order.begin(), initial_order.end(), [&](std::size_t lhs, std::size_t rhs) {
+		return by_initial[lhs] < by_initial[rhs];
+	});
+	std::sort(goal_order.begin(), goal_order.end(), [&](std::size_t lhs, std::size_t rhs) {
+		return by_goal[lhs] < by_goal[rhs];
+	});
+	if (initial_order != goal_order)
+		return "Agents on a part of the graph without branch must swap their order";
+
+	return std::string();
+}
+
+} // namespace cpf
@@ -1,67 +1,305 @@
 #include <cpf/FileSerializer.hpp>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
 namespace cpf {
 
-bool get_next_line(std::istream& is, std::string& line, std::size_t& line_num) {
-	do { ++line_num; } while (!std::getline(is, line) || line.empty() || line.front() == '#');
-	return static_cast<bool>(is);
+namespace {
+
+// Can't start a text file, whose first character is a digit, a space or a comment
+constexpr char BINARY_MAGIC[8] = { '\x89', 'C', 'P', 'F', '\r', '\n', '\x1a', '\n' };
+
+constexpr std::uint32_t BINARY_VERSION	= 1;
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+static_assert(
+	sizeof(node_t) == sizeof(std::uint64_t) && sizeof(std::size_t) == sizeof(std::uint64_t),
+	"The graph uses the words of a binary file as its offsets and nodes");
+
+struct BinaryHeader {
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t byte_order;
+	std::uint64_t node_count;
+	std::uint64_t edge_count;
+	std::uint64_t neighbour_count;
+	std::uint64_t agent_count;
+};
+
+constexpr std::size_t HEADER_WORDS = sizeof(BinaryHeader) / sizeof(std::uint64_t);
+
+[[noreturn]] void throw_binary_error(std::string const& hint) {
+	throw std::runtime_error("Couldn't parse binary file; Hint: " + hint);
+}
+
+/*
+	Words of the file following the header, or 0 when the counts of the header don't fit in `max_words`
+*/
+std::size_t body_words(BinaryHeader const& header, std::size_t max_words) {
+	if (header.node_count >= max_words || header.neighbour_count > max_words || header.agent_count > max_words)
+		return 0;
+	return header.node_count + 1 + header.neighbour_count + 2 * header.agent_count;
 }
 
-std::string get_next_line_or_throw(std::string const& error_hint, std::istream& is, std::size_t& line_num) {
-	std::string line;
-	if (get_next_line(is, line, line_num)) {
-		return line;
+BinaryHeader read_header(void const* data, std::size_t size) {
+	BinaryHeader header;
+	if (size < sizeof(header)) {
+		throw_binary_error("Truncated header");
 	}
+	std::memcpy(&header, data, sizeof(header));
+	if (std::memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+		throw_binary_error("Not a binary CPF file");
+	}
+	if (header.version != BINARY_VERSION) {
+		throw_binary_error("Unknown version " + std::to_string(header.version));
+	}
+	if (header.byte_order != BYTE_ORDER_MARK) {
+		throw_binary_error("Written with another byte order");
+	}
+	return header;
+}
+
+/*
+	Instance of the binary file held by `data`, `size` bytes kept alive by `storage`. The rows are checked, the graph
+	uses them in place
+*/
+std::pair<Graph, std::vector<Agent>>
+parse_binary(void const* data, std::size_t size, std::shared_ptr<void const> storage) {
+	auto header = read_header(data, size);
+	auto body	= body_words(header, size / sizeof(std::uint64_t));
+	if (body == 0 || size != (HEADER_WORDS + body) * sizeof(std::uint64_t)) {
+		throw_binary_error("The size of the file doesn't match its header");
+	}
+
+	std::size_t node_count = header.node_count;
+	auto offsets		   = static_cast<std::size_t const*>(data) + HEADER_WORDS;
+	auto neighbours		   = offsets + node_count + 1;
+	auto agent_nodes	   = neighbours + header.neighbour_count;
 
-	throw std::runtime_error("Couldn't parse file at line " + std::to_string(line_num) + "; Hint: " + error_hint);
+	if (offsets[0] != 0 || offsets[node_count] != header.neighbour_count) {
+		throw_binary_error("The offsets don't cover the neighbours");
+	}
+	for (node_t v = 0; v < node_count; ++v) {
+		if (offsets[v] > offsets[v + 1]) {
+			throw_binary_error("The offsets of node #" + std::to_string(v) + " decrease");
+		}
+		for (auto n = offsets[v]; n < offsets[v + 1]; ++n) {
+			if (neighbours[n] >= node_count || (n > offsets[v] && neighbours[n - 1] >= neighbours[n])) {
+				throw_binary_error("The neighbours of node #" + std::to_string(v) + " aren't sorted nodes");
+			}
+		}
+	}
+
+	std::vector<Agent> agents(header.agent_count);
+	for (std::size_t a = 0; a < agents.size(); ++a) {
+		agents[a] = { agent_nodes[2 * a], agent_nodes[2 * a + 1] };
+		if (agents[a].initial >= node_count || agents[a].goal >= node_count) {
+			throw_binary_error("Agent #" + std::to_string(a) + " references a node out of the graph");
+		}
+	}
+
+	Graph graph(node_count, header.edge_count, offsets, neighbours, std::move(storage));
+	return std::make_pair(std::move(graph), std::move(agents));
 }
 
-std::pair<Graph, std::vector<Agent>> deserialize(std::istream& is) {
-	std::size_t line_num = 0;
+/*
+	Binary instance read from a stream into memory
+*/
+std::pair<Graph, std::vector<Agent>> deserialize_binary(std::istream& is) {
+	BinaryHeader header;
+	if (!is.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+		throw_binary_error("Truncated header");
+	}
+	read_header(&header, sizeof(header));
 
-	auto str_graph_size	   = get_next_line_or_throw("Expecting number of nodes in graph", is, line_num);
-	std::size_t graph_size = std::stol(str_graph_size);
-	// std::cout << "Graph size: " << graph_size << '\n';
+	auto body = body_words(header, std::numeric_limits<std::size_t>::max() / (4 * sizeof(std::uint64_t)));
+	if (body == 0) {
+		throw_binary_error("The counts of the header are too large");
+	}
+	auto words = std::make_shared<std::vector<std::uint64_t>>(HEADER_WORDS + body);
+	std::memcpy(words->data(), &header, sizeof(header));
+	auto size = static_cast<std::streamsize>(body * sizeof(std::uint64_t));
+	if (!is.read(reinterpret_cast<char*>(words->data() + HEADER_WORDS), size)) {
+		throw_binary_error("Truncated file");
+	}
 
-	auto str_graph_edge_count	 = get_next_line_or_throw("Expecting number of edges in graph", is, line_num);
-	std::size_t graph_edge_count = std::stol(str_graph_edge_count);
-	// std::cout << "Graph edge count: " << graph_edge_count << '\n';
+	auto data		= words->data();
+	auto total_size = words->size() * sizeof(std::uint64_t);
+	return parse_binary(data, total_size, std::move(words));
+}
 
-	Graph graph(graph_size);
+/*
+	Cursor over the text of a CPF file: integers separated by blanks, and lines of comments starting with '#'
+	The line numbers are only counted to report an error
+*/
+class TextScanner {
+public:
+	TextScanner(char const* begin_, char const* end_) : begin{ begin_ }, it{ begin_ }, end{ end_ } {}
 
-	for (std::size_t e = 0; e < graph_edge_count; ++e) {
-		auto str_edge			= get_next_line_or_throw("Expecting edge #" + std::to_string(e), is, line_num);
-		std::size_t column		= 0;
-		std::size_t edge_first	= std::stol(str_edge, &column);
-		std::size_t edge_second = std::stol(str_edge.c_str() + column);
+	/*
+		Next integer, or throw std::runtime_error with the hint returned by `hint()`
+	*/
+	template<typename Hint>
+	std::size_t next(Hint hint) {
+		skip_blanks_and_comments();
+		if (it == end || !is_digit(*it)) {
+			fail(hint());
+		}
 
-		// std::cout << "Graph edge #" << e << ": " << edge_first << ", " << edge_second << '\n';
+		// No more digits than fit in a std::size_t
+		std::size_t value = 0;
+		auto first		  = it;
+		do {
+			value = value * 10 + static_cast<std::size_t>(*it - '0');
+			++it;
+		} while (it != end && is_digit(*it));
+		if (it - first > std::numeric_limits<std::size_t>::digits10) {
+			fail(hint());
+		}
+		return value;
+	}
+
+	/*
+		Bytes left, at least 2 per integer left
+	*/
+	std::size_t remaining() const noexcept { return static_cast<std::size_t>(end - it); }
 
-		graph[{ edge_first, edge_second }] = true;
+	[[noreturn]] void fail(std::string const& hint) const {
+		auto line = 1 + std::count(begin, it, '\n');
+		throw std::runtime_error("Couldn't parse file at line " + std::to_string(line) + "; Hint: " + hint);
 	}
 
-	auto str_agent_count	= get_next_line_or_throw("Expecting number of agents", is, line_num);
-	std::size_t agent_count = std::stol(str_agent_count);
-	// std::cout << "Agent count: " << agent_count << '\n';
+private:
+	static bool is_digit(char c) { return c >= '0' && c <= '9'; }
 
-	std::vector<Agent> agents;
-	agents.reserve(agent_count);
+	void skip_blanks_and_comments() {
+		while (it != end) {
+			if (*it == ' ' || *it == '\n' || *it == '\r' || *it == '\t') {
+				++it;
+			} else if (*it == '#') {
+				auto eol = static_cast<char const*>(std::memchr(it, '\n', static_cast<std::size_t>(end - it)));
+				it		 = eol ? eol : end;
+			} else {
+				break;
+			}
+		}
+	}
 
-	for (std::size_t a = 0; a < agent_count; ++a) {
-		auto str_agent			  = get_next_line_or_throw("Expecting agent #" + std::to_string(a), is, line_num);
-		std::size_t column		  = 0;
-		std::size_t agent_initial = std::stol(str_agent, &column);
-		std::size_t agent_goal	  = std::stol(str_agent.c_str() + column);
+	char const* begin;
+	char const* it;
+	char const* end;
+};
 
-		// std::cout << "Agent #" << a << ": " << agent_initial << ", " << agent_goal << '\n';
+/*
+	Instance of the text [begin, end), the vectors are sized from the counts read, as far as the text can hold them
+*/
+std::pair<Graph, std::vector<Agent>> parse_text(char const* begin, char const* end) {
+	TextScanner scanner(begin, end);
 
-		agents.push_back({ agent_initial, agent_goal });
+	auto graph_size		  = scanner.next([]() { return "Expecting number of nodes in graph"; });
+	auto graph_edge_count = scanner.next([]() { return "Expecting number of edges in graph"; });
+
+	std::vector<edge_t> edges;
+	edges.reserve(std::min(graph_edge_count, scanner.remaining() / 4));
+	for (std::size_t e = 0; e < graph_edge_count; ++e) {
+		auto hint		 = [e]() { return "Expecting edge #" + std::to_string(e); };
+		auto edge_first	 = scanner.next(hint);
+		auto edge_second = scanner.next(hint);
+		if (edge_first >= graph_size || edge_second >= graph_size) {
+			scanner.fail("Edge #" + std::to_string(e) + " references a node out of the graph");
+		}
+		edges.emplace_back(edge_first, edge_second);
 	}
 
+	Graph graph(graph_size, std::move(edges));
+
+	auto agent_count = scanner.next([]() { return "Expecting number of agents"; });
+
+	std::vector<Agent> agents;
+	agents.reserve(std::min(agent_count, scanner.remaining() / 4));
+	for (std::size_t a = 0; a < agent_count; ++a) {
+		auto hint		   = [a]() { return "Expecting agent #" + std::to_string(a); };
+		auto agent_initial = scanner.next(hint);
+		auto agent_goal	   = scanner.next(hint);
+		agents.push_back({ agent_initial, agent_goal });
+	}
 
 	return std::make_pair(std::move(graph), std::move(agents));
 }
 
+void write_u64(std::ostream& os, std::uint64_t value) {
+	os.write(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+} // namespace
+
+FileFormat detect_format(std::istream& is) {
+	return is.peek() == static_cast<unsigned char>(BINARY_MAGIC[0]) ? FileFormat::Binary : FileFormat::Text;
+}
+
+std::pair<Graph, std::vector<Agent>> deserialize(std::istream& is) {
+	if (detect_format(is) == FileFormat::Binary)
+		return deserialize_binary(is);
+
+	std::ostringstream text;
+	text << is.rdbuf();
+	auto const& str = text.str();
+	return parse_text(str.data(), str.data() + str.size());
+}
+
+std::pair<Graph, std::vector<Agent>> deserialize(char const* data, std::size_t size) {
+	if (size > 0 && data[0] == BINARY_MAGIC[0]) {
+		// Copied to be aligned on words
+		auto words = std::make_shared<std::vector<std::uint64_t>>(size / sizeof(std::uint64_t) + 1);
+		std::memcpy(words->data(), data, size);
+		auto copy = words->data();
+		return parse_binary(copy, size, std::move(words));
+	}
+	return parse_text(data, data + size);
+}
+
+std::pair<Graph, std::vector<Agent>> deserialize_file(std::string const& filename) {
+	// The mapping outlives the file descriptor
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	struct stat status;
+	if (fd < 0 || ::fstat(fd, &status) != 0) {
+		if (fd >= 0) {
+			::close(fd);
+		}
+		throw std::runtime_error("Unable to read file '" + filename + "'");
+	}
+	auto size = static_cast<std::size_t>(status.st_size);
+	if (size == 0) {
+		::close(fd);
+		return parse_text(nullptr, nullptr);
+	}
+	auto data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED) {
+		throw std::runtime_error("Unable to map file '" + filename + "'");
+	}
+
+	std::shared_ptr<void const> mapping(data, [size](void const* p) { ::munmap(const_cast<void*>(p), size); });
+	auto bytes = static_cast<char const*>(data);
+	if (bytes[0] == BINARY_MAGIC[0])
+		return parse_binary(data, size, std::move(mapping));
+
+	// The text is read once from start to end, and not kept
+	::madvise(data, size, MADV_SEQUENTIAL);
+	return parse_text(bytes, bytes + size);
+}
+
 void serialize(std::ostream& os, Graph const& graph, std::vector<Agent> const& agents) {
 	os << "# Number of nodes\n";
 	os << graph.size() << '\n';
@@ -71,8 +309,8 @@ void serialize(std::ostream& os, Graph const& graph, std::vector<Agent> const& a
 
 	os << "\n# Graph's edges\n";
 	for (node_t f = 0; f < graph.size(); ++f) {
-		for (node_t s = f; s < graph.size(); ++s) {
-			if (graph[{ f, s }]) {
+		for (node_t s : graph.neighbours_of(f)) {
+			if (s >= f) {
 				os << f << ' ' << s << '\n';
 			}
 		}
@@ -85,4 +323,34 @@ void serialize(std::ostream& os, Graph const& graph, std::vector<Agent> const& a
 	for (auto const& agent : agents) { os << agent.initial << ' ' << agent.goal << '\n'; }
 }
 
-} // namespace cpf
\ No newline at end of file
+void serialize_binary(std::ostream& os, Graph const& graph, std::vector<Agent> const& agents) {
+	BinaryHeader header;
+	std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+	header.version		   = BINARY_VERSION;
+	header.byte_order	   = BYTE_ORDER_MARK;
+	header.node_count	   = graph.size();
+	header.edge_count	   = graph.edge_count();
+	header.neighbour_count = 0;
+	for (node_t v = 0; v < graph.size(); ++v) { header.neighbour_count += graph.neighbours_of(v).size(); }
+	header.agent_count = agents.size();
+	os.write(reinterpret_cast<char const*>(&header), sizeof(header));
+
+	std::uint64_t offset = 0;
+	write_u64(os, offset);
+	for (node_t v = 0; v < graph.size(); ++v) {
+		offset += graph.neighbours_of(v).size();
+		write_u64(os, offset);
+	}
+	for (node_t v = 0; v < graph.size(); ++v) {
+		auto neighbours = graph.neighbours_of(v);
+		os.write(
+			reinterpret_cast<char const*>(neighbours.begin()),
+			static_cast<std::streamsize>(neighbours.size() * sizeof(node_t)));
+	}
+	for (auto const& agent : agents) {
+		write_u64(os, agent.initial);
+		write_u64(os, agent.goal);
+	}
+}
+
+} // namespace cpf
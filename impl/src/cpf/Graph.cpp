@@ -2,24 +2,94 @@
 
 namespace cpf {
 
-Graph::Graph(std::size_t node_count_) noexcept
-	: edges(node_count_ * (node_count_ + 1) / 2)
-	, node_count{ node_count_ } {}
-
-typename std::vector<bool>::const_reference Graph::operator[](std::pair<node_t, node_t> p) const noexcept {
-	auto f = p.first;
-	auto s = p.second;
-	if (f > s)
-		std::swap(f, s);
-	return edges[f + s * (s + 1) / 2];
+namespace {
+
+constexpr std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+constexpr std::uint64_t FNV_PRIME		 = 1099511628211ull;
+
+void mix(std::uint64_t& hash, std::uint64_t value) noexcept {
+	for (int byte = 0; byte < 8; ++byte) {
+		hash ^= (value >> (8 * byte)) & 0xff;
+		hash *= FNV_PRIME;
+	}
+}
+
+/*
+	Rows of the graphs built from edges
+*/
+struct OwnedRows {
+	std::vector<std::size_t> offsets;
+	std::vector<node_t> neighbours;
+};
+
+} // namespace
+
+Graph::Graph(std::size_t node_count_) : Graph(node_count_, std::vector<edge_t>{}) {}
+
+Graph::Graph(std::size_t node_count_, std::vector<edge_t> edges) : node_count{ node_count_ } {
+	auto rows		  = std::make_shared<OwnedRows>();
+	auto& row_offsets = rows->offsets;
+	row_offsets.assign(node_count + 1, 0);
+
+	// Count the degree of each node, then turn it into the offset of each node
+	for (auto const& edge : edges) {
+		++row_offsets[edge.first + 1];
+		if (edge.first != edge.second)
+			++row_offsets[edge.second + 1];
+	}
+	for (node_t node = 0; node < node_count; ++node) { row_offsets[node + 1] += row_offsets[node]; }
+
+	// Bucket the neighbours of each node, then free the edges
+	auto& row_neighbours = rows->neighbours;
+	row_neighbours.resize(row_offsets.back());
+	std::vector<std::size_t> next_slot(std::begin(row_offsets), std::end(row_offsets) - 1);
+	for (auto const& edge : edges) {
+		row_neighbours[next_slot[edge.first]++] = edge.second;
+		if (edge.first != edge.second)
+			row_neighbours[next_slot[edge.second]++] = edge.first;
+	}
+	std::vector<edge_t>().swap(edges);
+
+	// Sort each row and remove its duplicates, an edge may be given more than once and in both directions. The rows are
+	// moved towards the front as they shrink
+	std::size_t kept = 0;
+	for (node_t node = 0; node < node_count; ++node) {
+		auto first = std::begin(row_neighbours) + static_cast<std::ptrdiff_t>(row_offsets[node]);
+		auto last  = std::begin(row_neighbours) + static_cast<std::ptrdiff_t>(row_offsets[node + 1]);
+		std::sort(first, last);
+		last = std::unique(first, last);
+
+		row_offsets[node] = kept;
+		for (auto it = first; it != last; ++it) {
+			// Each edge is counted from its smallest node
+			if (*it >= node)
+				++edges_count;
+			row_neighbours[kept++] = *it;
+		}
+	}
+	row_offsets[node_count] = kept;
+	row_neighbours.resize(kept);
+
+	offsets	   = row_offsets.data();
+	neighbours = row_neighbours.data();
+	storage	   = std::move(rows);
 }
 
-typename std::vector<bool>::reference Graph::operator[](std::pair<node_t, node_t> p) noexcept {
-	auto f = p.first;
-	auto s = p.second;
-	if (f > s)
-		std::swap(f, s);
-	return edges[f + s * (s + 1) / 2];
+Graph::Graph(
+	std::size_t node_count_,
+	std::size_t edges_count_,
+	std::size_t const* offsets_,
+	node_t const* neighbours_,
+	std::shared_ptr<void const> storage_)
+	: storage{ std::move(storage_) }
+	, offsets{ offsets_ }
+	, neighbours{ neighbours_ }
+	, node_count{ node_count_ }
+	, edges_count{ edges_count_ } {}
+
+bool Graph::operator[](edge_t p) const noexcept {
+	auto n = neighbours_of(p.first);
+	return std::binary_search(n.begin(), n.end(), p.second);
 }
 
 std::size_t Graph::size() const noexcept {
@@ -27,20 +97,23 @@ std::size_t Graph::size() const noexcept {
 }
 
 std::size_t Graph::edge_count() const noexcept {
-	return std::count(std::begin(edges), std::end(edges), true);
+	return edges_count;
 }
 
-std::vector<node_t> Graph::neighbours_of(node_t node) const noexcept {
-	std::vector<node_t> neighbours;
-	neighbours.reserve(size());
-	for (node_t neighbour = 0; neighbour < size(); ++neighbour) {
-		if ((*this)[{ node, neighbour }]) {
-			neighbours.push_back(neighbour);
-		}
-	}
+Graph::Neighbours Graph::neighbours_of(node_t node) const noexcept {
+	return { neighbours + offsets[node], neighbours + offsets[node + 1] };
+}
 
-	return neighbours;
+std::uint64_t hash_graph(Graph const& graph) noexcept {
+	std::uint64_t hash = FNV_OFFSET_BASIS;
+	mix(hash, graph.size());
+	for (node_t v = 0; v < graph.size(); ++v) {
+		auto neighbours = graph.neighbours_of(v);
+		mix(hash, neighbours.size());
+		for (auto u : neighbours) { mix(hash, u); }
+	}
+	return hash;
 }
 
 
-} // namespace cpf
\ No newline at end of file
+} // namespace cpf
@@ -0,0 +1,26 @@
+#include <cpf/Interruption.hpp>
+
+namespace cpf {
+
+bool Interruption::interrupt() noexcept {
+	stop = true;
+	auto solver = watched.load();
+	if (!solver)
+		return false;
+	solver->interrupt();
+	return true;
+}
+
+bool Interruption::requested() const noexcept {
+	return stop;
+}
+
+void Interruption::watch(Interruptible& solver) noexcept {
+	watched = &solver;
+}
+
+void Interruption::release() noexcept {
+	watched = nullptr;
+}
+
+} // namespace cpf
@@ -0,0 +1,201 @@
+#include <cpf/LayeredMDD.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace cpf {
+
+constexpr std::size_t LayeredMDD::NOT_IN_LAYER;
+
+LayeredMDD::LayeredMDD(Graph const& graph_, MDD mdd_, node_t initial, std::size_t max_makespan_)
+	: graph{ &graph_ }
+	, mdd{ std::move(mdd_) }
+	, max_makespan_bound{ max_makespan_ }
+	, layers(1) {
+	if (mdd.distance_to_goal(initial) <= max_makespan_bound) {
+		layers.front().nodes.push_back(initial);
+	}
+	layers.front().removed.assign(layers.front().nodes.size(), false);
+}
+
+std::size_t LayeredMDD::max_makespan() const noexcept {
+	return max_makespan_bound;
+}
+
+std::size_t LayeredMDD::distance_to_goal(node_t node) const noexcept {
+	return mdd.distance_to_goal(node);
+}
+
+void LayeredMDD::extend(std::size_t t) {
+	while (layers.size() <= t) {
+		// The nodes reached from the previous layer which can still reach the goal in time
+		auto next = layers.size();
+		Layer layer;
+		for (auto v : layers.back().nodes) {
+			layer.nodes.push_back(v);
+			for (auto u : graph->neighbours_of(v)) { layer.nodes.push_back(u); }
+		}
+		std::sort(std::begin(layer.nodes), std::end(layer.nodes));
+		layer.nodes.erase(std::unique(std::begin(layer.nodes), std::end(layer.nodes)), std::end(layer.nodes));
+		layer.nodes.erase(
+			std::remove_if(
+				std::begin(layer.nodes),
+				std::end(layer.nodes),
+				[&](node_t v) {
+					auto distance = mdd.distance_to_goal(v);
+					return distance > max_makespan_bound || next > max_makespan_bound - distance;
+				}),
+			std::end(layer.nodes));
+		layer.removed.assign(layer.nodes.size(), false);
+
+		layers.push_back(std::move(layer));
+		link(next - 1);
+	}
+}
+
+std::size_t LayeredMDD::layers_count() const noexcept {
+	return layers.size();
+}
+
+std::vector<node_t> const& LayeredMDD::layer(std::size_t t) const noexcept {
+	return layers[t].nodes;
+}
+
+Range<std::uint32_t> LayeredMDD::successors(std::size_t t, std::size_t index) const noexcept {
+	auto const& l = layers[t];
+	assert(t + 1 < layers.size());
+	return { l.successors.data() + l.offsets[index], l.successors.data() + l.offsets[index + 1] };
+}
+
+std::size_t LayeredMDD::index_of(std::size_t t, node_t node) const noexcept {
+	auto const& nodes = layers[t].nodes;
+	auto it			  = std::lower_bound(std::begin(nodes), std::end(nodes), node);
+	if (it == std::end(nodes) || *it != node)
+		return NOT_IN_LAYER;
+	return static_cast<std::size_t>(it - std::begin(nodes));
+}
+
+void LayeredMDD::remove(std::size_t t, std::size_t index) {
+	layers[t].removed[index] = true;
+}
+
+std::size_t LayeredMDD::prune() {
+	auto last = layers.size() - 1;
+
+	// Without successor, the last layer excepted, which has none yet
+	auto remove_dead_ends = [&]() {
+		for (auto t = last; t-- > 0;) {
+			auto& l = layers[t];
+			for (std::size_t i = 0; i < l.nodes.size(); ++i) {
+				if (l.removed[i])
+					continue;
+				auto next	 = successors(t, i);
+				l.removed[i] = std::all_of(
+					next.begin(), next.end(), [&](std::uint32_t s) { return layers[t + 1].removed[s]; });
+			}
+		}
+	};
+
+	// Without predecessor, return whether a node was removed
+	std::vector<bool> reached;
+	auto remove_unreached = [&]() {
+		bool any = false;
+		for (std::size_t t = 1; t <= last; ++t) {
+			auto& previous = layers[t - 1];
+			reached.assign(layers[t].nodes.size(), false);
+			for (std::size_t i = 0; i < previous.nodes.size(); ++i) {
+				if (previous.removed[i])
+					continue;
+				for (auto s : successors(t - 1, i)) { reached[s] = true; }
+			}
+			for (std::size_t i = 0; i < reached.size(); ++i) {
+				if (!reached[i] && !layers[t].removed[i]) {
+					layers[t].removed[i] = true;
+					any					 = true;
+				}
+			}
+		}
+		return any;
+	};
+
+	do {
+		remove_dead_ends();
+	} while (remove_unreached());
+
+	// Compact the layers from the last one, the successors taking the new indices of the next layer
+	std::size_t removed_count = 0;
+	std::vector<std::uint32_t> new_index;
+	std::vector<std::uint32_t> next_new_index;
+	for (auto t = last + 1; t-- > 0;) {
+		auto& l = layers[t];
+		new_index.assign(l.nodes.size(), 0);
+		std::vector<node_t> nodes;
+		std::vector<std::uint32_t> offsets;
+		std::vector<std::uint32_t> kept_successors;
+		if (t < last) {
+			offsets.push_back(0);
+		}
+		for (std::size_t i = 0; i < l.nodes.size(); ++i) {
+			if (l.removed[i]) {
+				++removed_count;
+				continue;
+			}
+			new_index[i] = static_cast<std::uint32_t>(nodes.size());
+			nodes.push_back(l.nodes[i]);
+			if (t == last)
+				continue;
+
+			for (auto s : successors(t, i)) {
+				if (!layers[t + 1].removed[s]) {
+					kept_successors.push_back(next_new_index[s]);
+				}
+			}
+			offsets.push_back(static_cast<std::uint32_t>(kept_successors.size()));
+		}
+		l.nodes		 = std::move(nodes);
+		l.offsets	 = std::move(offsets);
+		l.successors = std::move(kept_successors);
+
+		// The flags of the layer t are still needed by the layer t-1, the ones of the layer t+1 aren't
+		if (t < last) {
+			layers[t + 1].removed.assign(layers[t + 1].nodes.size(), false);
+		}
+		std::swap(new_index, next_new_index);
+	}
+	layers.front().removed.assign(layers.front().nodes.size(), false);
+	return removed_count;
+}
+
+std::size_t LayeredMDD::size() const noexcept {
+	std::size_t count = 0;
+	for (auto const& l : layers) { count += l.nodes.size(); }
+	return count;
+}
+
+void LayeredMDD::link(std::size_t t) {
+	auto& l = layers[t];
+	l.offsets.assign(1, 0);
+	l.successors.clear();
+	for (auto v : l.nodes) {
+		// Waiting on v, then moving to each neighbour, both in increasing order once merged
+		auto first = l.successors.size();
+		auto wait  = index_of(t + 1, v);
+		if (wait != NOT_IN_LAYER) {
+			l.successors.push_back(static_cast<std::uint32_t>(wait));
+		}
+		for (auto u : graph->neighbours_of(v)) {
+			auto index = u == v ? NOT_IN_LAYER : index_of(t + 1, u);
+			if (index != NOT_IN_LAYER) {
+				l.successors.push_back(static_cast<std::uint32_t>(index));
+			}
+		}
+		std::inplace_merge(
+			std::begin(l.successors) + static_cast<std::ptrdiff_t>(first),
+			std::begin(l.successors) + static_cast<std::ptrdiff_t>(first) + (wait != NOT_IN_LAYER ? 1 : 0),
+			std::end(l.successors));
+		l.offsets.push_back(static_cast<std::uint32_t>(l.successors.size()));
+	}
+}
+
+} // namespace cpf
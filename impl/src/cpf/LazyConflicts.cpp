@@ -0,0 +1,115 @@
+#include <cpf/LazyConflicts.hpp>
+
+#include <cpf/ClauseShard.hpp>
+#include <cpf/Encoding.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace cpf {
+
+std::size_t push_violated_conflicts(
+	Context& context,
+	Graph const& graph,
+	std::size_t agent_count,
+	std::size_t makespan,
+	AtMostOneEncoding amo_encoding,
+	std::vector<bool> const& res) {
+	constexpr auto NO_AGENT = std::numeric_limits<std::size_t>::max();
+
+	auto positions_at = [&](std::size_t t, std::vector<node_t>& positions) {
+		for (std::size_t a = 0; a < agent_count; ++a) {
+			for (auto v : context.nodes_at(t, a)) {
+				if (res[static_cast<std::size_t>(context.get_var(t, a, v).id)]) {
+					positions[a] = v;
+				}
+			}
+		}
+	};
+
+	std::vector<node_t> current(agent_count);
+	std::vector<node_t> next(agent_count);
+	std::vector<std::size_t> agent_on(graph.size(), NO_AGENT);
+	std::vector<std::size_t> vertex_pushed_at(graph.size(), NO_AGENT);
+	std::vector<std::size_t> swap_pushed_at(graph.size(), NO_AGENT);
+	auto clauses_before = context.clauses_count();
+
+	ClauseShard shard;
+	auto index_of = [&](std::size_t t, node_t v) {
+		auto const& nodes = context.occupied_nodes(t);
+		return static_cast<std::size_t>(std::lower_bound(nodes.begin(), nodes.end(), v) - nodes.begin());
+	};
+
+	positions_at(0, current);
+	for (std::size_t t = 0; t <= makespan; ++t) {
+		for (std::size_t a = 0; a < agent_count; ++a) {
+			auto v = current[a];
+			if (agent_on[v] == NO_AGENT) {
+				agent_on[v] = a;
+				continue;
+			}
+
+			// Once per node, whatever the number of agents on it
+			if (vertex_pushed_at[v] == t)
+				continue;
+			vertex_pushed_at[v] = t;
+			auto i				= index_of(t, v);
+			push_vertex_conflict_clauses(context, shard, t, i, i + 1, amo_encoding);
+		}
+
+		if (t < makespan) {
+			positions_at(t + 1, next);
+			for (std::size_t a = 0; a < agent_count; ++a) {
+				auto v = current[a];
+				auto u = next[a];
+				auto b = agent_on[u];
+				if (u == v || b == NO_AGENT || b <= a || next[b] != v)
+					continue;
+
+				// The clauses of an edge are generated with all the edges of its smallest node
+				auto w = std::min(u, v);
+				if (swap_pushed_at[w] == t)
+					continue;
+				swap_pushed_at[w] = t;
+				auto i			  = index_of(t, w);
+				push_swap_conflict_clauses(context, shard, graph, t, i, i + 1);
+			}
+		}
+
+		for (auto v : current) { agent_on[v] = NO_AGENT; }
+		std::swap(current, next);
+	}
+
+	context.merge(shard);
+	return context.clauses_count() - clauses_before;
+}
+
+Glucose::lbool solve_lazily(
+	IncrementalSolver& solver,
+	Context& context,
+	Graph const& graph,
+	std::size_t agent_count,
+	std::size_t makespan,
+	AtMostOneEncoding amo_encoding,
+	std::vector<Variable> const& assumptions,
+	std::vector<bool>& res) {
+	std::size_t rounds = 0, clauses = 0;
+	Glucose::lbool ret;
+	for (;;) {
+		ret = solver.solve_assuming(assumptions, res);
+		++rounds;
+		if (ret != l_True)
+			break;
+
+		auto pushed = push_violated_conflicts(context, graph, agent_count, makespan, amo_encoding, res);
+		if (pushed == 0)
+			break;
+		clauses += pushed;
+	}
+
+	std::cout << "\tLazy conflicts: " << clauses << " clause(s) added in " << rounds << " solve(s)\n";
+	return ret;
+}
+
+} // namespace cpf
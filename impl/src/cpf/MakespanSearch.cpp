@@ -0,0 +1,67 @@
+#include <cpf/MakespanSearch.hpp>
+
+#include <algorithm>
+
+namespace cpf {
+
+bool parse_search_strategy(std::string const& name, SearchStrategy& out) {
+	if (name == "linear") {
+		out = SearchStrategy::Linear;
+	} else if (name == "exponential") {
+		out = SearchStrategy::Exponential;
+	} else if (name == "geometric") {
+		out = SearchStrategy::Geometric;
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
+MakespanSearch::MakespanSearch(SearchStrategy strategy_, std::size_t lower_bound, std::size_t upper_bound_) noexcept
+	: strategy{ strategy_ }
+	, lowest{ lower_bound }
+	, solvable{ upper_bound_ + 1 }
+	, upper_bound{ upper_bound_ }
+	, current{ lower_bound } {}
+
+bool MakespanSearch::done() const noexcept {
+	return lowest >= solvable;
+}
+
+std::size_t MakespanSearch::next() const noexcept {
+	return current;
+}
+
+void MakespanSearch::report(bool is_solvable) noexcept {
+	if (is_solvable) {
+		solvable = current;
+	} else {
+		lowest = current + 1;
+	}
+
+	if (done())
+		return;
+
+	if (strategy == SearchStrategy::Linear) {
+		current = lowest;
+	} else if (found()) {
+		// Binary search, the solvable makespan is excluded
+		current = lowest + (solvable - lowest) / 2;
+	} else if (strategy == SearchStrategy::Exponential) {
+		step *= 2;
+		current = std::min(upper_bound, lowest + step - 1);
+	} else {
+		current = std::min(upper_bound, std::max(lowest, current + current / 2));
+	}
+}
+
+bool MakespanSearch::found() const noexcept {
+	return solvable <= upper_bound;
+}
+
+std::size_t MakespanSearch::best() const noexcept {
+	return solvable;
+}
+
+} // namespace cpf
@@ -0,0 +1,131 @@
+#include <cpf/MakespanSolver.hpp>
+
+namespace cpf {
+
+namespace {
+
+void setup_solver(Glucose::SimpSolver& solver) {
+	solver.verbosity		  = -1;
+	solver.verbEveryConflicts = 10000;
+	solver.showModel		  = true;
+
+	solver.certifiedUNSAT = false;
+	solver.vbyte		  = false;
+}
+
+} // namespace
+
+void extract_model(Glucose::vec<Glucose::lbool> const& model, std::vector<bool>& res) {
+	auto const nvars = static_cast<std::size_t>(model.size());
+	std::vector<bool> values(nvars);
+	for (std::size_t i = 0; i < nvars; ++i) { values[i] = model[static_cast<int>(i)] == l_True; }
+
+	res = std::move(values);
+}
+
+MakespanSolver::MakespanSolver(Interruption& interruption_) : sink{ solver }, interruption{ &interruption_ } {
+	setup_solver(solver);
+	solver.parsing			  = 1;
+	solver.use_simplification = true;
+}
+
+void MakespanSolver::fix(Variable var) {
+	solver.addClause(sink.to_lit(var));
+}
+
+void MakespanSolver::hint(Variable var) {
+	if (var.id < solver.nVars()) {
+		solver.setPolarity(var.id, var.negated);
+	}
+}
+
+bool MakespanSolver::solve(std::vector<bool>& res) {
+	interruption->watch(*this);
+	auto ret = solve_limited(res);
+	interruption->release();
+	return ret == l_True;
+}
+
+Glucose::lbool MakespanSolver::solve_limited(std::vector<bool>& res) {
+	solver.parsing = 0;
+	solver.eliminate(true);
+	if (!solver.okay()) {
+		return l_False;
+	}
+
+	if (interruption->requested())
+		return l_Undef;
+
+	Glucose::vec<Glucose::Lit> no_assumptions;
+	auto ret = solver.solveLimited(no_assumptions);
+	if (ret == l_True) {
+		extract_model(solver.model, res);
+	}
+	return ret;
+}
+
+void MakespanSolver::interrupt() noexcept {
+	solver.interrupt();
+}
+
+IncrementalSolver::IncrementalSolver(Interruption& interruption_) : sink{ solver }, interruption{ &interruption_ } {
+	setup_solver(solver);
+	// Variable elimination would remove variables used by the next time steps
+	solver.use_simplification = false;
+}
+
+bool IncrementalSolver::solve(Variable bound, std::vector<bool>& res) {
+	if (interruption->requested())
+		return false;
+
+	Glucose::vec<Glucose::Lit> lits;
+	lits.push(sink.to_lit(bound));
+
+	interruption->watch(*this);
+	auto ret = solver.solveLimited(lits, false);
+	interruption->release();
+	if (ret == l_Undef) {
+		// Interrupted, nothing is known about this makespan so the formula is left as is
+		return false;
+	}
+	if (ret == l_False) {
+		// This makespan is proven impossible, so are the smaller ones
+		solver.addClause(~lits[0]);
+		return false;
+	}
+
+	extract_model(solver.model, res);
+	return true;
+}
+
+void IncrementalSolver::fix(Variable var) {
+	solver.addClause(sink.to_lit(var));
+}
+
+void IncrementalSolver::hint(Variable var) {
+	if (var.id < solver.nVars()) {
+		solver.setPolarity(var.id, var.negated);
+	}
+}
+
+Glucose::lbool IncrementalSolver::solve_assuming(std::vector<Variable> const& assumptions, std::vector<bool>& res) {
+	if (interruption->requested())
+		return l_Undef;
+
+	Glucose::vec<Glucose::Lit> lits;
+	for (auto var : assumptions) { lits.push(sink.to_lit(var)); }
+
+	interruption->watch(*this);
+	auto ret = solver.solveLimited(lits, false);
+	interruption->release();
+	if (ret == l_True) {
+		extract_model(solver.model, res);
+	}
+	return ret;
+}
+
+void IncrementalSolver::interrupt() noexcept {
+	solver.interrupt();
+}
+
+} // namespace cpf
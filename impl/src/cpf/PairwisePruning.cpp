@@ -0,0 +1,310 @@
+#include <cpf/PairwisePruning.hpp>
+
+#include <cstdint>
+#include <utility>
+
+namespace cpf {
+
+namespace {
+
+/*
+	Beyond this number of joint states (the pairs of nodes of all the layers), a pair of agents isn't checked
+*/
+constexpr std::size_t MAX_JOINT_STATES = std::size_t(1) << 24;
+
+constexpr std::size_t WORD_BITS = 64;
+
+std::uint64_t bit(std::size_t index) {
+	return std::uint64_t{ 1 } << (index % WORD_BITS);
+}
+
+bool test(std::uint64_t const* bits, std::size_t index) {
+	return (bits[index / WORD_BITS] & bit(index)) != 0;
+}
+
+void clear(std::uint64_t* bits, std::size_t index) {
+	bits[index / WORD_BITS] &= ~bit(index);
+}
+
+bool none(std::uint64_t const* bits, std::size_t words) {
+	for (std::size_t w = 0; w < words; ++w) {
+		if (bits[w])
+			return false;
+	}
+	return true;
+}
+
+/*
+	Call `f` with the index of each bit set
+*/
+template<typename F>
+void for_each_bit(std::uint64_t const* bits, std::size_t words, F f) {
+	for (std::size_t w = 0; w < words; ++w) {
+		for (auto m = bits[w]; m; m &= m - 1) { f(w * WORD_BITS + static_cast<std::size_t>(__builtin_ctzll(m))); }
+	}
+}
+
+/*
+	Whether `lhs & rhs` has a bit set other than `except`
+*/
+bool intersect_except(std::uint64_t const* lhs, std::uint64_t const* rhs, std::size_t words, std::size_t except) {
+	for (std::size_t w = 0; w < words; ++w) {
+		auto m = lhs[w] & rhs[w];
+		if (w == except / WORD_BITS) {
+			m &= ~bit(except);
+		}
+		if (m)
+			return true;
+	}
+	return false;
+}
+
+/*
+	Bitsets of the same width, one after the other
+*/
+class BitRows {
+public:
+	void assign(std::size_t rows, std::size_t bits) {
+		width = (bits + WORD_BITS - 1) / WORD_BITS;
+		words.assign(rows * width, 0);
+	}
+
+	std::size_t row_words() const noexcept { return width; }
+
+	std::uint64_t* row(std::size_t r) noexcept { return words.data() + r * width; }
+	std::uint64_t const* row(std::size_t r) const noexcept { return words.data() + r * width; }
+
+private:
+	std::size_t width = 0;
+	std::vector<std::uint64_t> words;
+};
+
+/*
+	Edges of an mdd as bitsets: `successors[t].row(i)` are the successors of `layer(t)[i]` in the layer t+1, and
+	`predecessors[t].row(j)` the predecessors of `layer(t+1)[j]` in the layer t
+*/
+struct EdgeMasks {
+	std::vector<BitRows> successors;
+	std::vector<BitRows> predecessors;
+};
+
+EdgeMasks edge_masks(LayeredMDD const& mdd, std::size_t last) {
+	EdgeMasks masks;
+	masks.successors.resize(last);
+	masks.predecessors.resize(last);
+	for (std::size_t t = 0; t < last; ++t) {
+		auto from = mdd.layer(t).size();
+		auto to	  = mdd.layer(t + 1).size();
+		masks.successors[t].assign(from, to);
+		masks.predecessors[t].assign(to, from);
+		for (std::size_t i = 0; i < from; ++i) {
+			for (auto s : mdd.successors(t, i)) {
+				masks.successors[t].row(i)[s / WORD_BITS] |= bit(s);
+				masks.predecessors[t].row(s)[i / WORD_BITS] |= bit(i);
+			}
+		}
+	}
+	return masks;
+}
+
+/*
+	Nodes of two agents to remove, as (time step, index in the layer)
+*/
+struct PairRemovals {
+	std::vector<std::pair<std::size_t, std::size_t>> lhs;
+	std::vector<std::pair<std::size_t, std::size_t>> rhs;
+};
+
+/*
+	Whether the sorted nodes of both layers have one in common
+*/
+bool intersects(std::vector<node_t> const& lhs, std::vector<node_t> const& rhs) {
+	auto l = std::begin(lhs);
+	auto r = std::begin(rhs);
+	while (l != std::end(lhs) && r != std::end(rhs)) {
+		if (*l < *r) {
+			++l;
+		} else if (*r < *l) {
+			++r;
+		} else {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+	Whether the paths of the two agents may collide: on a node at the same time step, or by swapping their nodes
+*/
+bool interact(LayeredMDD const& lhs, LayeredMDD const& rhs, std::size_t last) {
+	for (std::size_t t = 0; t <= last; ++t) {
+		if (intersects(lhs.layer(t), rhs.layer(t)))
+			return true;
+		if (t < last && intersects(lhs.layer(t), rhs.layer(t + 1)) && intersects(lhs.layer(t + 1), rhs.layer(t)))
+			return true;
+	}
+	return false;
+}
+
+/*
+	Nodes of the two agents on no pair of conflict-free paths, through their joint mdd: the pairs of nodes reached at
+	each time step from the initial nodes, then the ones among them still reaching the goals at the last time step
+	The joint states (i, j) of a time step are a row of bits j per node i of `lhs`, so the moves of `rhs` are followed
+	a word at a time. Nothing is removed when the joint mdd has too many states to be checked
+*/
+PairRemovals check_pair(LayeredMDD const& lhs, LayeredMDD const& rhs, EdgeMasks const& rhs_masks, std::size_t last) {
+	PairRemovals removals;
+
+	std::size_t states = 0;
+	for (std::size_t t = 0; t <= last; ++t) { states += lhs.layer(t).size() * rhs.layer(t).size(); }
+	if (states > MAX_JOINT_STATES)
+		return removals;
+
+	std::vector<BitRows> joint(last + 1);
+	for (std::size_t t = 0; t <= last; ++t) { joint[t].assign(lhs.layer(t).size(), rhs.layer(t).size()); }
+
+	// The move of `lhs` from the node i of t to its successor s, between two different nodes, forbids the move of `rhs`
+	// the other way round: from y, the index of the same node as s in its layer t, to x, the index of the same node as
+	// i in its layer t+1. False when there's no such move
+	auto swap_of = [&](std::size_t t, std::size_t i, std::uint32_t s, std::size_t& y, std::size_t& x) {
+		auto from = lhs.layer(t)[i];
+		auto to	  = lhs.layer(t + 1)[s];
+		if (from == to)
+			return false;
+		y = rhs.index_of(t, to);
+		x = rhs.index_of(t + 1, from);
+		return y != LayeredMDD::NOT_IN_LAYER && x != LayeredMDD::NOT_IN_LAYER;
+	};
+
+	// Forward, from the initial nodes, which are different
+	joint[0].row(0)[0] = bit(0);
+	std::vector<std::uint64_t> moves;
+	std::vector<std::uint64_t> next;
+	for (std::size_t t = 0; t < last; ++t) {
+		auto const& successors	 = rhs_masks.successors[t];
+		auto const& predecessors = rhs_masks.predecessors[t];
+		auto words				 = joint[t].row_words();
+		auto next_words			 = joint[t + 1].row_words();
+		for (std::size_t i = 0; i < lhs.layer(t).size(); ++i) {
+			auto row = joint[t].row(i);
+			if (none(row, words))
+				continue;
+
+			// Nodes of the layer t+1 `rhs` moves to from the row
+			moves.assign(next_words, 0);
+			for_each_bit(row, words, [&](std::size_t j) {
+				for (std::size_t w = 0; w < next_words; ++w) { moves[w] |= successors.row(j)[w]; }
+			});
+
+			for (auto s : lhs.successors(t, i)) {
+				next = moves;
+				// x is only reached by swapping, from y
+				std::size_t y, x;
+				if (swap_of(t, i, s, y, x) && test(row, y) && !intersect_except(predecessors.row(x), row, words, y)) {
+					clear(next.data(), x);
+				}
+				auto vertex = rhs.index_of(t + 1, lhs.layer(t + 1)[s]);
+				if (vertex != LayeredMDD::NOT_IN_LAYER) {
+					clear(next.data(), vertex);
+				}
+
+				auto next_row = joint[t + 1].row(s);
+				for (std::size_t w = 0; w < next_words; ++w) { next_row[w] |= next[w]; }
+			}
+		}
+	}
+
+	// Backward, from the goals: `reaching.row(s)` are the nodes of `rhs` at t with a successor in the row s of t+1
+	BitRows reaching;
+	std::vector<std::uint64_t> alive;
+	for (auto t = last; t-- > 0;) {
+		auto const& successors	 = rhs_masks.successors[t];
+		auto const& predecessors = rhs_masks.predecessors[t];
+		auto words				 = joint[t].row_words();
+		auto next_words			 = joint[t + 1].row_words();
+		reaching.assign(lhs.layer(t + 1).size(), rhs.layer(t).size());
+		for (std::size_t s = 0; s < lhs.layer(t + 1).size(); ++s) {
+			auto row = reaching.row(s);
+			for_each_bit(joint[t + 1].row(s), next_words, [&](std::size_t j) {
+				for (std::size_t w = 0; w < words; ++w) { row[w] |= predecessors.row(j)[w]; }
+			});
+		}
+
+		for (std::size_t i = 0; i < lhs.layer(t).size(); ++i) {
+			auto row = joint[t].row(i);
+			if (none(row, words))
+				continue;
+
+			alive.assign(words, 0);
+			for (auto s : lhs.successors(t, i)) {
+				next.assign(reaching.row(s), reaching.row(s) + words);
+				// y only reaches the row s by swapping, to x
+				std::size_t y, x;
+				if (swap_of(t, i, s, y, x) && test(next.data(), y)
+					&& !intersect_except(successors.row(y), joint[t + 1].row(s), next_words, x)) {
+					clear(next.data(), y);
+				}
+				for (std::size_t w = 0; w < words; ++w) { alive[w] |= next[w]; }
+			}
+			for (std::size_t w = 0; w < words; ++w) { row[w] &= alive[w]; }
+		}
+	}
+
+	std::vector<std::uint64_t> rhs_kept;
+	for (std::size_t t = 0; t <= last; ++t) {
+		auto words = joint[t].row_words();
+		rhs_kept.assign(words, 0);
+		for (std::size_t i = 0; i < lhs.layer(t).size(); ++i) {
+			auto row = joint[t].row(i);
+			if (none(row, words)) {
+				removals.lhs.emplace_back(t, i);
+			}
+			for (std::size_t w = 0; w < words; ++w) { rhs_kept[w] |= row[w]; }
+		}
+		for (std::size_t j = 0; j < rhs.layer(t).size(); ++j) {
+			if (!test(rhs_kept.data(), j)) {
+				removals.rhs.emplace_back(t, j);
+			}
+		}
+	}
+	return removals;
+}
+
+} // namespace
+
+std::size_t prune_pairwise(std::vector<LayeredMDD>& mdds, ThreadPool& pool) {
+	if (mdds.empty())
+		return 0;
+
+	auto last = mdds.front().max_makespan();
+	std::vector<EdgeMasks> masks(mdds.size());
+	pool.run(mdds.size(), [&](std::size_t a) { masks[a] = edge_masks(mdds[a], last); });
+
+	std::vector<std::pair<std::size_t, std::size_t>> pairs;
+	for (std::size_t a = 0; a < mdds.size(); ++a) {
+		for (std::size_t b = a + 1; b < mdds.size(); ++b) { pairs.emplace_back(a, b); }
+	}
+
+	std::vector<PairRemovals> removals(pairs.size());
+	pool.run(pairs.size(), [&](std::size_t p) {
+		auto const& lhs = mdds[pairs[p].first];
+		auto const& rhs = mdds[pairs[p].second];
+		if (!lhs.layer(0).empty() && !rhs.layer(0).empty() && interact(lhs, rhs, last)) {
+			removals[p] = check_pair(lhs, rhs, masks[pairs[p].second], last);
+		}
+	});
+
+	for (std::size_t p = 0; p < pairs.size(); ++p) {
+		for (auto const& node : removals[p].lhs) { mdds[pairs[p].first].remove(node.first, node.second); }
+		for (auto const& node : removals[p].rhs) { mdds[pairs[p].second].remove(node.first, node.second); }
+	}
+
+	std::vector<std::size_t> removed(mdds.size());
+	pool.run(mdds.size(), [&](std::size_t a) { removed[a] = mdds[a].prune(); });
+
+	std::size_t count = 0;
+	for (auto r : removed) { count += r; }
+	return count;
+}
+
+} // namespace cpf
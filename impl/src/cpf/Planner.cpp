@@ -0,0 +1,655 @@
+#include <cpf/Planner.hpp>
+
+#include <cpf/ClauseArena.hpp>
+#include <cpf/ClauseShard.hpp>
+#include <cpf/ClauseSink.hpp>
+#include <cpf/Context.hpp>
+#include <cpf/Encoding.hpp>
+#include <cpf/LayeredMDD.hpp>
+#include <cpf/LazyConflicts.hpp>
+#include <cpf/MDD.hpp>
+#include <cpf/MakespanSolver.hpp>
+#include <cpf/PairwisePruning.hpp>
+#include <cpf/PortfolioSolver.hpp>
+#include <cpf/SpeculativeSearch.hpp>
+#include <cpf/SumOfCosts.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+namespace cpf {
+
+namespace {
+
+/*
+	Each family of clauses is generated for a single time step, over a range of agents or of occupied nodes, into a
+	shard. The ranges are split into jobs of a fixed size run by the thread pool, and the shards are merged in the order
+	of the jobs: the clauses and the variables don't depend on the number of threads
+*/
+constexpr std::size_t GENERATION_JOB_SIZE = 64;
+
+/*
+	Run the jobs on the pool, each into its own shard, then merge the shards into the context in the order of the jobs
+*/
+void run_generation_jobs(
+	Context& context,
+	ThreadPool& pool,
+	std::vector<std::function<void(ClauseShard&)>> const& jobs) {
+	std::vector<ClauseShard> shards(jobs.size());
+	pool.run(jobs.size(), [&](std::size_t i) { jobs[i](shards[i]); });
+	for (auto const& shard : shards) { context.merge(shard); }
+}
+
+/*
+	Map each node to the agent starting on it (resp. ending on it), or `agents.size()` if there's none
+*/
+std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+map_agents_to_nodes(Graph const& graph, std::vector<Agent> const& agents) {
+	std::vector<std::size_t> initial_nodes_with_agents(graph.size(), agents.size());
+	std::vector<std::size_t> goal_nodes_with_agents(graph.size(), agents.size());
+
+	for (std::size_t a = 0; a < agents.size(); ++a) {
+		auto const& agent = agents[a];
+
+		if (initial_nodes_with_agents.at(agent.initial) < agents.size()) {
+			throw std::runtime_error("Agent already exists at node " + std::to_string(agent.initial));
+		}
+		initial_nodes_with_agents[agent.initial] = a;
+
+		if (goal_nodes_with_agents.at(agent.goal) < agents.size()) {
+			throw std::runtime_error("Agent already exists at node " + std::to_string(agent.goal));
+		}
+		goal_nodes_with_agents[agent.goal] = a;
+	}
+
+	return std::make_pair(std::move(initial_nodes_with_agents), std::move(goal_nodes_with_agents));
+}
+
+// Init
+void push_init_clauses(
+	Context& context, std::size_t agent_count, std::vector<std::size_t> const& initial_nodes_with_agents) {
+	for (std::size_t a = 0; a < agent_count; ++a) {
+		for (auto v : context.nodes_at(0, a)) {
+			auto x = context.get_var(0, a, v);
+			if (initial_nodes_with_agents[v] == a) {
+				context.push(x);
+			} else {
+				context.push(!x);
+			}
+		}
+	}
+}
+
+/*
+	Create the variables of the agent `a` at the time step `makespan`. With its mdd, they are the nodes of its layer,
+	and the nodes too far from the goal are forbidden until the makespan is large enough:
+	!B(makespan + dist(v, goal) - 1) or !X(makespan, a, v)
+*/
+void create_time_step_variables(
+	Context& context, Graph const& graph, std::size_t a, std::size_t makespan, LayeredMDD* mdd) {
+	if (!mdd) {
+		for (std::size_t v = 0; v < graph.size(); ++v) { context.create_var(makespan, a, v); }
+		return;
+	}
+
+	mdd->extend(makespan);
+	for (auto v : mdd->layer(makespan)) {
+		auto x		  = context.create_var(makespan, a, v);
+		auto distance = mdd->distance_to_goal(v);
+		if (distance > 0) {
+			auto bound = !context.makespan_bound(makespan + distance - 1);
+			context.push(bound | !x);
+		}
+	}
+}
+
+/*
+	Add the time step `makespan` to a context holding the time steps [0, makespan-1] (or an empty context when
+	`makespan` is 0). No clause depends on the makespan, so the context of a makespan is reused for the next ones:
+	only the new time step, its clauses and the transitions from the previous time step are generated.
+	The goal constraints are B(makespan) => X(makespan, a, goal), assuming B(makespan) restricts the context to the
+	same solutions as a context built for this makespan only
+	With `lazy_conflicts`, the conflict clauses #2 and #4 are left out, see `push_violated_conflicts`
+	With the mdds, their layers are extended to `makespan` and the clauses #1 follow their edges
+	Return the first agent which can't be on its goal at `makespan`, or `agents.size()` when all of them can
+*/
+std::size_t extend_context(
+	Context& context,
+	ClauseSink& sink,
+	Graph const& graph,
+	std::vector<Agent> const& agents,
+	std::size_t makespan,
+	std::vector<LayeredMDD>* mdds,
+	AtMostOneEncoding amo_encoding,
+	bool lazy_conflicts,
+	ThreadPool& pool) {
+	if (makespan == 0) {
+		context = Context(0, agents.size(), graph.size(), sink);
+	} else {
+		context.extend(makespan);
+	}
+
+	// The variables are created on this thread, their ids follow the order of creation
+	for (std::size_t a = 0; a < agents.size(); ++a) {
+		create_time_step_variables(context, graph, a, makespan, mdds ? &(*mdds)[a] : nullptr);
+	}
+	context.index_agents(makespan);
+
+	std::vector<std::function<void(ClauseShard&)>> jobs;
+	auto split = [&](std::size_t count, std::function<void(ClauseShard&, std::size_t, std::size_t)> family) {
+		for (std::size_t first = 0; first < count; first += GENERATION_JOB_SIZE) {
+			auto last = std::min(count, first + GENERATION_JOB_SIZE);
+			jobs.emplace_back([=](ClauseShard& shard) { family(shard, first, last); });
+		}
+	};
+
+	auto const& ctx = context;
+	if (makespan == 0) {
+		auto nodes_with_agents = map_agents_to_nodes(graph, agents);
+		push_init_clauses(context, agents.size(), nodes_with_agents.first);
+	} else {
+		auto t = makespan - 1;
+		split(agents.size(), [&, t](ClauseShard& shard, std::size_t first, std::size_t last) {
+			if (mdds) {
+				push_mdd_movement_clauses(ctx, shard, *mdds, t, first, last);
+			} else {
+				push_movement_clauses(ctx, shard, graph, t, first, last);
+			}
+		});
+		if (!lazy_conflicts) {
+			split(ctx.occupied_nodes(t).size(), [&, t](ClauseShard& shard, std::size_t first, std::size_t last) {
+				push_swap_conflict_clauses(ctx, shard, graph, t, first, last);
+			});
+		}
+	}
+
+	if (!lazy_conflicts) {
+		split(ctx.occupied_nodes(makespan).size(), [&](ClauseShard& shard, std::size_t first, std::size_t last) {
+			push_vertex_conflict_clauses(ctx, shard, makespan, first, last, amo_encoding);
+		});
+	}
+	split(agents.size(), [&](ClauseShard& shard, std::size_t first, std::size_t last) {
+		push_single_position_clauses(ctx, shard, makespan, first, last, amo_encoding);
+	});
+
+	run_generation_jobs(context, pool, jobs);
+
+	// Goal, B(makespan) => X(makespan, a, goal)
+	auto bound			= !context.makespan_bound(makespan);
+	std::size_t no_path = agents.size();
+	for (std::size_t a = 0; a < agents.size(); ++a) {
+		auto goal = agents[a].goal;
+		if (context.contains(makespan, a, goal)) {
+			context.push(bound | context.get_var(makespan, a, goal));
+		} else {
+			context.push(bound);
+			no_path = std::min(no_path, a);
+		}
+	}
+
+	return no_path;
+}
+
+/*
+	Shortest path from the initial node of the agent to its goal, following the distances of its MDD
+*/
+std::vector<node_t> shortest_path(
+	Graph const& graph, Agent const& agent, LayeredMDD const& mdd) {
+	std::vector<node_t> path{ agent.initial };
+	while (path.back() != agent.goal) {
+		auto closest = path.back();
+		for (auto neighbour : graph.neighbours_of(path.back())) {
+			if (mdd.distance_to_goal(neighbour) < mdd.distance_to_goal(closest)) {
+				closest = neighbour;
+			}
+		}
+		if (closest == path.back())
+			break;
+		path.push_back(closest);
+	}
+	return path;
+}
+
+/*
+	Pairwise pruning for `makespan`: the mdds of the agents bounded by `makespan` are pruned against each other, see
+	`prune_pairwise`, and the variables of the pruned nodes are forbidden for this makespan and the smaller ones:
+	!B(makespan) or !X(t, a, v). The nodes already too far from the goal are skipped, their distance guard covers them
+	Return the number of clauses pushed
+*/
+std::size_t push_pairwise_pruning(
+	Context& context,
+	Graph const& graph,
+	std::vector<Agent> const& agents,
+	DistanceOracle& oracle,
+	std::size_t makespan,
+	ThreadPool& pool) {
+	std::vector<LayeredMDD> mdds;
+	mdds.reserve(agents.size());
+	for (auto const& agent : agents) {
+		mdds.emplace_back(graph, MDD(oracle, agent), agent.initial, makespan);
+		mdds.back().extend(makespan);
+	}
+	prune_pairwise(mdds, pool);
+
+	auto bound		  = !context.makespan_bound(makespan);
+	std::size_t count = 0;
+	for (std::size_t a = 0; a < agents.size(); ++a) {
+		if (mdds[a].layer(0).empty()) {
+			// The agent can't reach its goal along with another one
+			context.push(bound);
+			return count + 1;
+		}
+
+		for (std::size_t t = 0; t <= makespan; ++t) {
+			for (auto v : context.nodes_at(t, a)) {
+				auto distance = mdds[a].distance_to_goal(v);
+				if (distance <= makespan - t && mdds[a].index_of(t, v) == LayeredMDD::NOT_IN_LAYER) {
+					context.push(bound | !context.get_var(t, a, v));
+					++count;
+				}
+			}
+		}
+	}
+	return count;
+}
+
+/*
+	Path of each agent in the plan `res` of `makespan`, `paths[a][t]` being the node of agent a at time t
+	With the mdds the context was built from, only the successors of the node at t are looked at for t+1
+*/
+std::vector<std::vector<node_t>> extract_paths(
+	Context const& context,
+	std::size_t agent_count,
+	std::size_t makespan,
+	std::vector<LayeredMDD> const* mdds,
+	std::vector<bool> const& res) {
+	std::vector<std::vector<node_t>> paths(agent_count);
+	auto holds = [&](std::size_t t, std::size_t a, std::size_t index) {
+		return res[static_cast<std::size_t>(context.get_var_at(t, a, index).id)];
+	};
+
+	for (std::size_t a = 0; a < agent_count; ++a) {
+		if (mdds) {
+			// The only node of the first layer is the initial one
+			std::size_t index = 0;
+			paths[a].push_back((*mdds)[a].layer(0)[index]);
+			for (std::size_t t = 0; t < makespan; ++t) {
+				auto next = (*mdds)[a].successors(t, index);
+				index = *std::find_if(next.begin(), next.end(), [&](std::uint32_t s) { return holds(t + 1, a, s); });
+				paths[a].push_back((*mdds)[a].layer(t + 1)[index]);
+			}
+			continue;
+		}
+
+		for (std::size_t t = 0; t <= makespan; ++t) {
+			for (auto v : context.nodes_at(t, a)) {
+				if (res[static_cast<std::size_t>(context.get_var(t, a, v).id)]) {
+					paths[a].push_back(v);
+				}
+			}
+		}
+	}
+	return paths;
+}
+
+/*
+	Node of an agent at time `t`, it waits on its goal once its path is over
+*/
+node_t position(std::vector<node_t> const& path, std::size_t t) {
+	return path[std::min(t, path.size() - 1)];
+}
+
+/*
+	Two agents whose paths collide, on a node or by swapping their nodes, false when all the paths are compatible
+*/
+bool find_collision(
+	Graph const& graph,
+	std::vector<std::vector<node_t>> const& paths,
+	std::pair<std::size_t, std::size_t>& agents) {
+	constexpr auto NO_AGENT = std::numeric_limits<std::size_t>::max();
+
+	std::size_t duration = 0;
+	for (auto const& path : paths) { duration = std::max(duration, path.size()); }
+
+	// Agent on each node at the previous and at the current time step
+	std::vector<std::size_t> previous(graph.size(), NO_AGENT);
+	std::vector<std::size_t> current(graph.size(), NO_AGENT);
+	for (std::size_t t = 0; t < duration; ++t) {
+		for (std::size_t a = 0; a < paths.size(); ++a) {
+			auto v = position(paths[a], t);
+			if (current[v] != NO_AGENT) {
+				agents = { current[v], a };
+				return true;
+			}
+			current[v] = a;
+		}
+
+		if (t > 0) {
+			for (std::size_t a = 0; a < paths.size(); ++a) {
+				auto from = position(paths[a], t - 1);
+				auto to	  = position(paths[a], t);
+				auto b	  = previous[to];
+				if (from != to && b != NO_AGENT && b != a && position(paths[b], t) == from) {
+					agents = { a, b };
+					return true;
+				}
+			}
+			for (auto const& path : paths) { previous[position(path, t - 1)] = NO_AGENT; }
+		}
+		std::swap(previous, current);
+	}
+	return false;
+}
+
+} // namespace
+
+PlanStatus plan(
+	Graph const& graph,
+	std::vector<Agent> const& agents,
+	PlanningOptions const& options,
+	ThreadPool& generation_pool,
+	DistanceOracle& oracle,
+	std::vector<std::vector<node_t>> hints,
+	Interruption& interruption,
+	std::vector<std::vector<node_t>>& paths) {
+	Context context;
+	std::vector<bool> res;
+
+	// Without the incremental mode, the clauses are kept to be given to the solver of each makespan
+	ClauseArena arena;
+	IncrementalSolver incremental_solver(interruption);
+	std::size_t next_time_step = 0;
+
+	// Create the mdds, also used without --no-mdd to get the distances of the agents to their goal. Their layers
+	// don't go beyond the largest makespan tried
+	auto max_makespan = static_cast<std::size_t>(options.makespan_interval.second);
+	std::vector<LayeredMDD> mdds;
+	mdds.reserve(agents.size());
+	for (auto const& agent : agents) { mdds.emplace_back(graph, MDD(oracle, agent), agent.initial, max_makespan); }
+
+	// No makespan is smaller than the distance of an agent to its goal
+	std::size_t lower_bound = static_cast<std::size_t>(options.makespan_interval.first);
+	for (std::size_t a = 0; a < agents.size(); ++a) {
+		auto distance = mdds[a].distance_to_goal(agents[a].initial);
+		if (distance == std::numeric_limits<std::size_t>::max()) {
+			std::cout << "Agent " << a << " can't reach its goal\n";
+			return PlanStatus::NoSolution;
+		}
+		lower_bound = std::max(lower_bound, distance);
+	}
+	std::cout << "Lower bound of the makespan: " << lower_bound << '\n';
+
+	if (options.use_hints) {
+		hints.resize(agents.size());
+		for (std::size_t a = 0; a < agents.size(); ++a) {
+			if (hints[a].empty()) {
+				hints[a] = shortest_path(graph, agents[a], mdds[a]);
+			}
+		}
+	} else {
+		hints.clear();
+	}
+	// The incremental solver keeps the phases of the previous solves, only the new time steps are hinted
+	std::size_t next_hinted_time_step = 0;
+
+	// Makespans whose variables were pruned pairwise
+	std::set<int> pruned_makespans;
+
+	// Extend the context up to `makespan` (already extended time steps are skipped), false if an agent can't reach its
+	// goal at `makespan`. With the pairwise pruning, the variables of `makespan` are then pruned once
+	auto extend_up_to = [&](int makespan) {
+		// The smaller time steps are only extended through, they aren't tried
+		auto no_path = agents.size();
+		for (; next_time_step <= static_cast<std::size_t>(makespan); ++next_time_step) {
+			no_path = extend_context(
+				context,
+				options.use_incremental ? static_cast<ClauseSink&>(incremental_solver.sink) : arena,
+				graph,
+				agents,
+				next_time_step,
+				options.use_mdd ? &mdds : nullptr,
+				options.amo_encoding,
+				options.lazy_conflicts,
+				generation_pool);
+		}
+		if (no_path < agents.size()) {
+			std::cout << "\tNo path for agent " << no_path << " found in the MDD\n";
+		}
+		bool has_path = no_path == agents.size();
+		if (has_path && options.pairwise_pruning && pruned_makespans.insert(makespan).second) {
+			auto clock_begin = std::chrono::steady_clock::now();
+			auto count		 = push_pairwise_pruning(
+				  context, graph, agents, oracle, static_cast<std::size_t>(makespan), generation_pool);
+			std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - clock_begin;
+			std::cout << "\tPairwise pruning forbade " << count << " variables in " << duration.count() << "ms\n";
+		}
+		return has_path;
+	};
+
+	// Start iterative methods
+
+	int makespan = static_cast<int>(lower_bound);
+	bool found	 = false;
+	if (options.speculative_window > 1) {
+		found = speculative_search(
+			context,
+			arena,
+			extend_up_to,
+			{ makespan, options.makespan_interval.second },
+			options.speculative_window,
+			hints,
+			interruption,
+			makespan,
+			res);
+	} else {
+		MakespanSearch search(
+			options.search_strategy, lower_bound, static_cast<std::size_t>(options.makespan_interval.second));
+		std::vector<bool> model;
+		while (!search.done() && !interruption.requested()) {
+			makespan		 = static_cast<int>(search.next());
+			auto clock_begin = std::chrono::steady_clock::now();
+			auto report_time = [&]() {
+				auto clock_end									   = std::chrono::steady_clock::now();
+				std::chrono::duration<double, std::milli> duration = clock_end - clock_begin;
+				std::cout << "\tTook " << duration.count() << "ms\n";
+			};
+
+			std::cout << "Generating SAT problem with a bounded makespan of " << makespan << "...\n";
+			if (!extend_up_to(makespan)) {
+				report_time();
+				search.report(false);
+				continue;
+			}
+
+			std::cout << "\t#Variables: " << context.variables_count() << '\n';
+			std::cout << "\t#Clauses: " << context.clauses_count() << '\n';
+			{
+				std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - clock_begin;
+				std::cout << "\tGenerated in " << duration.count() << "ms\n";
+			}
+
+			std::cout << "\tSolving...\n";
+			if (options.use_incremental && next_hinted_time_step <= static_cast<std::size_t>(makespan)) {
+				hint_paths(
+					incremental_solver, context, hints, next_hinted_time_step, static_cast<std::size_t>(makespan));
+				next_hinted_time_step = static_cast<std::size_t>(makespan) + 1;
+			}
+
+			bool solved;
+			if (options.lazy_conflicts) {
+				auto bound = context.makespan_bound(makespan);
+				auto ret   = solve_lazily(
+					  incremental_solver,
+					  context,
+					  graph,
+					  agents.size(),
+					  static_cast<std::size_t>(makespan),
+					  options.amo_encoding,
+					  { bound },
+					  model);
+				if (ret == l_False) {
+					// As IncrementalSolver::solve, this makespan and the smaller ones are impossible
+					incremental_solver.fix(!bound);
+				}
+				solved = ret == l_True;
+			} else if (options.use_incremental) {
+				solved = incremental_solver.solve(context.makespan_bound(makespan), model);
+			} else if (options.solver_threads > 1) {
+				PortfolioSolver portfolio(options.solver_threads, interruption);
+				solved = solve_makespan(
+					portfolio, context, arena, static_cast<std::size_t>(makespan), hints, model);
+			} else {
+				MakespanSolver makespan_solver(interruption);
+				solved = solve_makespan(
+					makespan_solver, context, arena, static_cast<std::size_t>(makespan), hints, model);
+			}
+
+			report_time();
+			if (interruption.requested())
+				break;
+
+			if (solved) {
+				// Once a makespan is solvable, only smaller ones are tried
+				res = std::move(model);
+			} else {
+				std::cout << "\tFailed to solve.\n";
+			}
+			search.report(solved);
+		}
+
+		found = search.found();
+		if (found) {
+			makespan = static_cast<int>(search.best());
+		}
+	}
+
+	if (interruption.requested()) {
+		std::cout << "\tFailed to solve.\n";
+		return PlanStatus::Interrupted;
+	}
+
+	if (!found) {
+		std::cout << "\tFailed to solve.\n";
+		return PlanStatus::NoSolution;
+	}
+
+	std::cout << "\tSuccessfully solved\n";
+
+	if (options.objective == Objective::SumOfCosts) {
+		std::cout << "Lowering the sum of costs with a makespan of " << makespan << "...\n";
+		auto plan_paths = extract_paths(
+			context, agents.size(), static_cast<std::size_t>(makespan), options.use_mdd ? &mdds : nullptr, res);
+		minimise_sum_of_costs(
+			context,
+			graph,
+			agents,
+			mdds,
+			static_cast<std::size_t>(makespan),
+			options.use_incremental ? &incremental_solver : nullptr,
+			arena,
+			plan_paths,
+			options.amo_encoding,
+			options.lazy_conflicts,
+			interruption,
+			res);
+		if (interruption.requested()) {
+			std::cout << "\tInterrupted, the sum of costs may not be the smallest\n";
+		}
+	}
+
+	paths = extract_paths(
+		context, agents.size(), static_cast<std::size_t>(makespan), options.use_mdd ? &mdds : nullptr, res);
+	return PlanStatus::Solved;
+}
+
+PlanStatus plan_independent_groups(
+	Graph const& graph,
+	std::vector<Agent> const& agents,
+	PlanningOptions const& options,
+	ThreadPool& generation_pool,
+	DistanceOracle& oracle,
+	std::vector<std::vector<node_t>> const& hints,
+	Interruption& interruption,
+	std::vector<std::vector<node_t>>& paths) {
+	std::vector<std::vector<std::size_t>> groups(agents.size());
+	std::vector<std::size_t> group_of(agents.size());
+	for (std::size_t a = 0; a < agents.size(); ++a) {
+		groups[a]	= { a };
+		group_of[a] = a;
+	}
+
+	paths.assign(agents.size(), {});
+	auto plan_group = [&](std::size_t g) {
+		// The paths planned so far, even colliding, are hints for the merged group
+		std::vector<Agent> group_agents;
+		std::vector<std::vector<node_t>> group_hints;
+		std::cout << "Planning the group of agent(s)";
+		for (auto a : groups[g]) {
+			std::cout << " #" << a;
+			group_agents.push_back(agents[a]);
+			if (!paths[a].empty()) {
+				group_hints.push_back(paths[a]);
+			} else if (a < hints.size()) {
+				group_hints.push_back(hints[a]);
+			} else {
+				group_hints.emplace_back();
+			}
+		}
+		std::cout << '\n';
+
+		std::vector<std::vector<node_t>> group_paths;
+		auto status = plan(
+			graph,
+			group_agents,
+			options,
+			generation_pool,
+			oracle,
+			std::move(group_hints),
+			interruption,
+			group_paths);
+		if (status == PlanStatus::Solved) {
+			for (std::size_t i = 0; i < groups[g].size(); ++i) { paths[groups[g][i]] = std::move(group_paths[i]); }
+		}
+		return status;
+	};
+
+	for (std::size_t g = 0; g < groups.size(); ++g) {
+		auto status = plan_group(g);
+		if (status != PlanStatus::Solved)
+			return status;
+	}
+
+	std::pair<std::size_t, std::size_t> colliding;
+	while (find_collision(graph, paths, colliding)) {
+		auto kept	= group_of[colliding.first];
+		auto merged = group_of[colliding.second];
+		for (auto a : groups[merged]) { group_of[a] = kept; }
+		groups[kept].insert(groups[kept].end(), groups[merged].begin(), groups[merged].end());
+		std::sort(groups[kept].begin(), groups[kept].end());
+		groups[merged].clear();
+
+		auto status = plan_group(kept);
+		if (status != PlanStatus::Solved)
+			return status;
+	}
+
+	std::size_t length = 0;
+	for (auto const& path : paths) { length = std::max(length, path.size()); }
+	for (auto& path : paths) { path.resize(length, path.back()); }
+
+	std::size_t group_count = 0, largest_group = 0;
+	for (auto const& group : groups) {
+		group_count += !group.empty();
+		largest_group = std::max(largest_group, group.size());
+	}
+	std::cout << "Independent groups: " << group_count << ", the largest has " << largest_group << " agent(s)\n";
+	return PlanStatus::Solved;
+}
+
+} // namespace cpf
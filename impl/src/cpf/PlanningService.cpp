@@ -0,0 +1,152 @@
+#include <cpf/PlanningService.hpp>
+
+#include <cpf/FileSerializer.hpp>
+#include <cpf/Replanner.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace cpf {
+
+namespace {
+
+// Requests solved together at most, the ones beyond wait for the next batch
+constexpr std::size_t MAX_BATCH_SIZE = 256;
+
+// Graphs kept, the least recently used one is dropped beyond
+constexpr std::size_t MAX_CACHED_GRAPHS = 16;
+
+// Distance tables kept per graph, they are all dropped beyond
+constexpr std::size_t MAX_CACHED_TABLES = 4096;
+
+bool same_graph(Graph const& lhs, Graph const& rhs) noexcept {
+	if (lhs.size() != rhs.size() || lhs.edge_count() != rhs.edge_count())
+		return false;
+
+	for (node_t v = 0; v < lhs.size(); ++v) {
+		auto l = lhs.neighbours_of(v);
+		auto r = rhs.neighbours_of(v);
+		if (l.size() != r.size() || !std::equal(l.begin(), l.end(), r.begin()))
+			return false;
+	}
+	return true;
+}
+
+} // namespace
+
+PlanningService::PlanningService(
+	std::size_t worker_count, AtMostOneEncoding amo_encoding_, std::size_t max_makespan_)
+	: pool(worker_count)
+	, amo_encoding{ amo_encoding_ }
+	, max_makespan{ max_makespan_ } {}
+
+void PlanningService::serve(std::istream& is, std::ostream& os) {
+	std::vector<Request> batch;
+	std::vector<std::string> answers;
+	for (;;) {
+		// Wait for a request, then take the ones already received with it
+		batch.clear();
+		Request request;
+		if (!read_request(is, request))
+			return;
+		batch.push_back(std::move(request));
+		while (batch.size() < MAX_BATCH_SIZE && is.rdbuf()->in_avail() > 0 && read_request(is, request)) {
+			batch.push_back(std::move(request));
+		}
+
+		answers.assign(batch.size(), std::string());
+		pool.run(batch.size(), [&](std::size_t i) { answers[i] = answer(batch[i]); });
+		for (auto const& answer : answers) { os << answer; }
+		os.flush();
+	}
+}
+
+bool PlanningService::read_request(std::istream& is, Request& request) const {
+	request = Request();
+	std::string line;
+	do {
+		if (!std::getline(is, line))
+			return false;
+	} while (line.empty());
+
+	std::stringstream header(line);
+	std::string command;
+	header >> command >> request.id;
+	if (command != "solve" || request.id.empty()) {
+		request.error = "Expecting 'solve <id>', got '" + line + "'";
+		return true;
+	}
+
+	while (std::getline(is, line)) {
+		if (line == "end")
+			return true;
+		request.instance += line;
+		request.instance += '\n';
+	}
+	request.error = "Missing 'end'";
+	return true;
+}
+
+std::string PlanningService::answer(Request const& request) {
+	std::stringstream os;
+	os << "plan " << (request.id.empty() ? "?" : request.id) << ' ';
+	try {
+		if (!request.error.empty()) {
+			throw std::runtime_error(request.error);
+		}
+
+		std::stringstream is(request.instance);
+		auto instance	   = deserialize(is);
+		auto const& agents = instance.second;
+		for (auto const& agent : agents) {
+			if (agent.initial >= instance.first.size() || agent.goal >= instance.first.size()) {
+				throw std::runtime_error("Agent out of the graph");
+			}
+		}
+
+		// The cached graph is kept alive while its oracle is used
+		auto cached = find_graph(std::move(instance.first));
+		Replanner replanner(cached->graph, agents, cached->oracle, amo_encoding, max_makespan);
+		std::vector<std::vector<node_t>> paths;
+		if (replanner.plan(paths) != Replanner::Status::Solved) {
+			os << "no-solution\n";
+		} else {
+			os << "solved " << (paths.empty() ? 0 : paths.front().size() - 1) << '\n';
+			for (auto const& path : paths) {
+				for (auto v : path) { os << v << ' '; }
+				os << '\n';
+			}
+		}
+	} catch (std::exception const& e) {
+		os << "error " << e.what() << '\n';
+	}
+	os << "end\n";
+	return os.str();
+}
+
+std::shared_ptr<PlanningService::CachedGraph> PlanningService::find_graph(Graph graph) {
+	auto hash = hash_graph(graph);
+
+	std::lock_guard<std::mutex> lock(graphs_mutex);
+	auto& cached = graphs[hash];
+	if (!cached || !same_graph(cached->graph, graph)) {
+		// A collision replaces the graph cached with the same hash
+		cached		   = std::make_shared<CachedGraph>();
+		cached->graph  = std::move(graph);
+		cached->oracle = std::make_shared<DistanceOracle>(cached->graph, MAX_CACHED_TABLES);
+	}
+	cached->last_use = ++uses;
+	auto found		 = cached;
+
+	if (graphs.size() > MAX_CACHED_GRAPHS) {
+		using Entry = decltype(graphs)::value_type;
+		auto oldest = std::min_element(std::begin(graphs), std::end(graphs), [](Entry const& lhs, Entry const& rhs) {
+			return lhs.second->last_use < rhs.second->last_use;
+		});
+		graphs.erase(oldest);
+	}
+	return found;
+}
+
+} // namespace cpf
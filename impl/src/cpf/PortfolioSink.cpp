@@ -0,0 +1,18 @@
+#include <cpf/PortfolioSink.hpp>
+
+namespace cpf {
+
+PortfolioSink::PortfolioSink(Glucose::MultiSolvers& solvers_) noexcept : solvers{ &solvers_ } {}
+
+void PortfolioSink::add_clause(Variable const* first, Variable const* last) {
+	buffer.clear();
+	for (; first != last; ++first) { buffer.push(to_lit(*first)); }
+	solvers->addClause(buffer);
+}
+
+Glucose::Lit PortfolioSink::to_lit(Variable const& var) {
+	while (var.id >= solvers->nVars()) { solvers->newVar(); }
+	return Glucose::mkLit(var.id, var.negated);
+}
+
+} // namespace cpf
@@ -0,0 +1,82 @@
+#include <cpf/PortfolioSolver.hpp>
+
+#include <cpf/MakespanSolver.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+namespace cpf {
+
+namespace {
+
+/*
+	How often the portfolio's wait for its first solver to finish is woken up
+*/
+constexpr std::chrono::milliseconds PORTFOLIO_WAKE_UP_INTERVAL(10);
+
+} // namespace
+
+PortfolioSolver::PortfolioSolver(int thread_count, Interruption& interruption_)
+	: sink{ *this }
+	, interruption{ &interruption_ } {
+	nbthreads		   = thread_count;
+	nbsolvers		   = thread_count;
+	use_simplification = true;
+}
+
+PortfolioSolver::~PortfolioSolver() {
+	// MultiSolvers doesn't release them
+	for (int i = 0; i < solvers.size(); ++i) { delete solvers[i]; }
+	for (int i = 0; i < threads.size(); ++i) { free(threads[i]); }
+	delete sharedcomp;
+}
+
+void PortfolioSolver::fix(Variable var) {
+	sink.add_clause(&var, &var + 1);
+}
+
+void PortfolioSolver::hint(Variable var) {
+	if (var.id < nVars()) {
+		solvers[0]->setPolarity(var.id, var.negated);
+	}
+}
+
+void PortfolioSolver::interrupt() noexcept {
+	for (int i = 0; i < solvers.size(); ++i) { solvers[i]->interrupt(); }
+}
+
+bool PortfolioSolver::solve(std::vector<bool>& res) {
+	// The clones of the first solver are made when solving, after the simplifications
+	if (!simplify() || !eliminate() || !okay())
+		return false;
+
+	if (interruption->requested())
+		return false;
+
+	interruption->watch(*this);
+	// MultiSolvers waits for the signal of the first solver to finish without locking the mutex of the wait, the
+	// signal is lost when it comes before the wait and the solve never returns. It is repeated until it does
+	std::atomic<bool> returned{ false };
+	std::thread waker([this, &returned]() {
+		while (!returned) {
+			std::this_thread::sleep_for(PORTFOLIO_WAKE_UP_INTERVAL);
+			if (sharedcomp->jobFinished() || interruption->requested()) {
+				pthread_cond_broadcast(&cfinished);
+			}
+		}
+	});
+	auto ret = MultiSolvers::solve();
+	returned = true;
+	waker.join();
+	interruption->release();
+	if (ret != l_True) {
+		return false;
+	}
+
+	extract_model(model, res);
+	return true;
+}
+
+} // namespace cpf
@@ -0,0 +1,147 @@
+#include <cpf/PrioritizedPlanner.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+namespace cpf {
+
+namespace {
+
+constexpr std::size_t NO_AGENT = std::numeric_limits<std::size_t>::max();
+
+/*
+	Nodes used by the agents already planned, each one follows its path then stays on its goal
+*/
+class Reservations {
+public:
+	explicit Reservations(std::size_t node_count_)
+		: node_count{ node_count_ }, busy_until(node_count_, 0), parked(node_count_, { NO_AGENT, 0 }) {}
+
+	std::size_t agent_at(node_t node, std::size_t t) const {
+		auto it = occupied.find(t * node_count + node);
+		if (it != occupied.end())
+			return it->second;
+		return parked[node].second <= t ? parked[node].first : NO_AGENT;
+	}
+
+	/*
+		No agent enters `node` from `t` on
+	*/
+	bool free_from(node_t node, std::size_t t) const noexcept { return busy_until[node] <= t; }
+
+	/*
+		Nothing moves from this time step on
+	*/
+	std::size_t still_from() const noexcept { return last_arrival; }
+
+	void reserve(std::size_t agent, std::vector<node_t> const& path) {
+		for (std::size_t t = 0; t + 1 < path.size(); ++t) {
+			occupied[t * node_count + path[t]] = agent;
+			busy_until[path[t]]				   = std::max(busy_until[path[t]], t + 1);
+		}
+		parked[path.back()] = { agent, path.size() - 1 };
+		last_arrival		= std::max(last_arrival, path.size() - 1);
+	}
+
+private:
+	std::size_t node_count;
+	std::unordered_map<std::size_t, std::size_t> occupied;
+	std::vector<std::size_t> busy_until;
+	std::vector<std::pair<std::size_t, std::size_t>> parked; // Agent on its goal and its time of arrival
+	std::size_t last_arrival = 0;
+};
+
+struct Step {
+	node_t node;
+	std::size_t parent; // Index in the previous layer
+};
+
+/*
+	Shortest path of `agent` avoiding the reservations, false if there is none
+	After `still_from()` the layers of the search can only grow, the search stops as soon as one doesn't
+*/
+bool find_path(
+	Graph const& graph,
+	Agent const& agent,
+	Reservations const& reservations,
+	std::vector<std::size_t>& seen_at,
+	std::vector<node_t>& path) {
+	std::fill(seen_at.begin(), seen_at.end(), NO_AGENT);
+
+	std::vector<std::vector<Step>> layers;
+	layers.push_back({ { agent.initial, 0 } });
+	for (std::size_t t = 0;; ++t) {
+		auto const& layer = layers.back();
+		for (std::size_t i = 0; i < layer.size(); ++i) {
+			if (layer[i].node != agent.goal || !reservations.free_from(agent.goal, t))
+				continue;
+
+			path.resize(t + 1);
+			for (auto step = t + 1; step-- > 0;) {
+				path[step] = layers[step][i].node;
+				i		   = layers[step][i].parent;
+			}
+			return true;
+		}
+
+		std::vector<Step> next;
+		for (std::size_t i = 0; i < layer.size(); ++i) {
+			auto from	= layer[i].node;
+			auto move_to = [&](node_t to) {
+				if (seen_at[to] == t + 1 || reservations.agent_at(to, t + 1) != NO_AGENT)
+					return;
+				// Swapping with another agent
+				auto other = reservations.agent_at(to, t);
+				if (other != NO_AGENT && reservations.agent_at(from, t + 1) == other)
+					return;
+
+				seen_at[to] = t + 1;
+				next.push_back({ to, i });
+			};
+
+			move_to(from);
+			for (auto neighbour : graph.neighbours_of(from)) { move_to(neighbour); }
+		}
+
+		if (next.empty() || (t >= reservations.still_from() && next.size() == layer.size()))
+			return false;
+		layers.push_back(std::move(next));
+	}
+}
+
+} // namespace
+
+bool plan_prioritized(Graph const& graph, std::vector<Agent> const& agents, std::vector<std::vector<node_t>>& paths) {
+	std::vector<std::size_t> seen_at(graph.size());
+	std::vector<std::size_t> order(agents.size());
+	for (std::size_t i = 0; i < order.size(); ++i) { order[i] = i; }
+
+	// An agent blocked by the previous ones is planned first on the next attempt
+	for (std::size_t attempt = 0; attempt <= agents.size(); ++attempt) {
+		Reservations reservations(graph.size());
+		paths.assign(agents.size(), {});
+
+		auto blocked = order.end();
+		for (auto it = order.begin(); it != order.end(); ++it) {
+			if (!find_path(graph, agents[*it], reservations, seen_at, paths[*it])) {
+				blocked = it;
+				break;
+			}
+			reservations.reserve(*it, paths[*it]);
+		}
+
+		if (blocked == order.end()) {
+			std::size_t length = 0;
+			for (auto const& path : paths) { length = std::max(length, path.size()); }
+			for (auto& path : paths) { path.resize(length, path.back()); }
+			return true;
+		}
+		if (blocked == order.begin())
+			return false;
+		std::rotate(order.begin(), blocked, blocked + 1);
+	}
+	return false;
+}
+
+} // namespace cpf
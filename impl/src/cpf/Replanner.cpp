@@ -0,0 +1,467 @@
+#include <cpf/Replanner.hpp>
+
+#include <cpf/Encoding.hpp>
+#include <cpf/Feasibility.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace cpf {
+
+namespace {
+
+constexpr std::size_t UNREACHABLE = std::numeric_limits<std::size_t>::max();
+
+edge_t sorted(edge_t edge) noexcept {
+	if (edge.first > edge.second)
+		std::swap(edge.first, edge.second);
+	return edge;
+}
+
+} // namespace
+
+Delta read_delta(std::istream& is) {
+	Delta delta;
+	std::string line;
+	while (std::getline(is, line)) {
+		std::stringstream ss(line);
+		std::string change;
+		if (!(ss >> change) || change.front() == '#')
+			continue;
+
+		bool read;
+		if (change == "elapsed") {
+			read = static_cast<bool>(ss >> delta.elapsed);
+		} else if (change == "remove") {
+			std::size_t a;
+			read = static_cast<bool>(ss >> a);
+			delta.removed_agents.push_back(a);
+		} else if (change == "goal") {
+			std::pair<std::size_t, node_t> new_goal;
+			read = static_cast<bool>(ss >> new_goal.first >> new_goal.second);
+			delta.new_goals.push_back(new_goal);
+		} else if (change == "add") {
+			Agent agent;
+			read = static_cast<bool>(ss >> agent.initial >> agent.goal);
+			delta.added_agents.push_back(agent);
+		} else if (change == "block") {
+			edge_t edge;
+			read = static_cast<bool>(ss >> edge.first >> edge.second);
+			delta.blocked_edges.push_back(edge);
+		} else if (change == "obstacle") {
+			node_t node;
+			read = static_cast<bool>(ss >> node);
+			delta.blocked_nodes.push_back(node);
+		} else {
+			throw std::runtime_error("Unknown change '" + change + "'");
+		}
+
+		if (!read) {
+			throw std::runtime_error("Malformed change '" + line + "'");
+		}
+	}
+	return delta;
+}
+
+Replanner::Replanner(
+	Graph graph_, std::vector<Agent> agents_, AtMostOneEncoding amo_encoding_, std::size_t max_makespan_)
+	: Replanner(std::move(graph_), std::move(agents_), nullptr, amo_encoding_, max_makespan_) {}
+
+Replanner::Replanner(
+	Graph graph_,
+	std::vector<Agent> agents_,
+	std::shared_ptr<DistanceOracle> oracle_,
+	AtMostOneEncoding amo_encoding_,
+	std::size_t max_makespan_)
+	: graph{ std::move(graph_) }
+	, agents{ std::move(agents_) }
+	, oracle{ std::move(oracle_) }
+	, active(agents.size(), true)
+	, arrivals(agents.size(), 0)
+	, last_plan(agents.size())
+	, amo_encoding{ amo_encoding_ }
+	, max_makespan{ max_makespan_ }
+	, sink{ solver } {
+	for (auto const& agent : agents) {
+		check_node(agent.initial);
+		check_node(agent.goal);
+	}
+
+	if (!oracle) {
+		oracle = std::make_shared<DistanceOracle>(graph);
+	}
+	mdds.reserve(agents.size());
+	for (auto const& agent : agents) { mdds.emplace_back(*oracle, agent); }
+
+	solver.verbosity = -1;
+	// Variable elimination would remove variables used by the next time steps and the next changes
+	solver.use_simplification = false;
+}
+
+void Replanner::warm_start(std::vector<std::vector<node_t>> paths) {
+	if (paths.size() != agents.size()) {
+		throw std::runtime_error("The plan doesn't have a path for each agent");
+	}
+	last_plan = std::move(paths);
+}
+
+void Replanner::apply(Delta const& delta) {
+	advance(delta.elapsed);
+	for (auto a : delta.removed_agents) { remove_agent(a); }
+	for (auto const& new_goal : delta.new_goals) { change_goal(new_goal.first, new_goal.second); }
+	for (auto const& agent : delta.added_agents) { add_agent(agent); }
+
+	auto edges = delta.blocked_edges;
+	for (auto node : delta.blocked_nodes) {
+		check_node(node);
+		for (auto neighbour : graph.neighbours_of(node)) { edges.emplace_back(node, neighbour); }
+	}
+	if (!edges.empty()) {
+		block_edges(std::move(edges));
+	}
+}
+
+Replanner::Status Replanner::plan(std::vector<std::vector<node_t>>& paths) {
+	solver.clearInterrupt();
+
+	std::vector<Agent> active_agents;
+	std::size_t lower_bound = 0;
+	for (std::size_t a = 0; a < agents.size(); ++a) {
+		if (!active[a])
+			continue;
+
+		active_agents.push_back(agents[a]);
+		lower_bound = std::max(lower_bound, mdds[a].distance_to_goal(agents[a].initial));
+	}
+	if (!find_infeasibility(graph, active_agents).empty() || lower_bound == UNREACHABLE)
+		return Status::NoSolution;
+
+	Glucose::vec<Glucose::Lit> assumptions;
+	for (auto makespan = origin + lower_bound; makespan - origin <= max_makespan; ++makespan) {
+		extend_to(makespan);
+
+		assumptions.clear();
+		assumptions.push(sink.to_lit(context.makespan_bound(makespan)));
+		for (std::size_t a = 0; a < agents.size(); ++a) {
+			if (!active[a])
+				continue;
+
+			if (!context.contains(origin, a, agents[a].initial))
+				return Status::NoSolution;
+			assumptions.push(sink.to_lit(selectors[a]));
+			assumptions.push(sink.to_lit(context.get_var(origin, a, agents[a].initial)));
+
+			// Phase hints, the agent waits on the last node of its path once it's over
+			auto const& path = last_plan[a];
+			for (auto t = origin; !path.empty() && t <= makespan; ++t) {
+				auto v = path[std::min(t - origin, path.size() - 1)];
+				if (!context.contains(t, a, v))
+					continue;
+
+				auto var = context.get_var(t, a, v);
+				if (var.id < solver.nVars()) {
+					solver.setPolarity(var.id, var.negated);
+				}
+			}
+		}
+
+		auto ret = solver.solveLimited(assumptions, false);
+		if (ret == l_Undef)
+			return Status::Interrupted;
+		if (ret == l_False)
+			continue;
+
+		paths.assign(agents.size(), {});
+		for (std::size_t a = 0; a < agents.size(); ++a) {
+			for (auto t = origin; active[a] && t <= makespan; ++t) {
+				for (auto v : context.nodes_at(t, a)) {
+					if (solver.modelValue(sink.to_lit(context.get_var(t, a, v))) == l_True) {
+						paths[a].push_back(v);
+						break;
+					}
+				}
+			}
+		}
+		last_plan = paths;
+		return Status::Solved;
+	}
+	return Status::NoSolution;
+}
+
+void Replanner::interrupt() {
+	solver.interrupt();
+}
+
+Graph const& Replanner::current_graph() const noexcept {
+	return graph;
+}
+
+std::vector<Agent> const& Replanner::current_agents() const noexcept {
+	return agents;
+}
+
+bool Replanner::is_active(std::size_t agent_id) const noexcept {
+	return active[agent_id];
+}
+
+bool Replanner::encoded() const noexcept {
+	return next_time_step > 0;
+}
+
+void Replanner::extend_to(std::size_t makespan) {
+	for (; next_time_step <= makespan; ++next_time_step) {
+		auto t = next_time_step;
+		if (t == 0) {
+			context = Context(0, agents.size(), graph.size(), sink);
+			for (std::size_t a = 0; a < agents.size(); ++a) {
+				selectors.push_back(context.create_aux_var());
+				if (!active[a]) {
+					context.push(!selectors[a]);
+				}
+			}
+		} else {
+			context.extend(t);
+		}
+
+		for (std::size_t a = 0; a < agents.size(); ++a) { create_agent_variables(t, a); }
+		context.index_agents(t);
+
+		ClauseShard shard;
+		if (t > 0) {
+			push_movement_clauses(context, shard, graph, t - 1, 0, agents.size());
+			push_swap_conflict_clauses(context, shard, graph, t - 1, 0, context.occupied_nodes(t - 1).size());
+		}
+		push_vertex_conflict_clauses(context, shard, t, 0, context.occupied_nodes(t).size(), amo_encoding);
+		push_single_position_clauses(context, shard, t, 0, agents.size(), amo_encoding);
+		context.merge(shard);
+
+		for (std::size_t a = 0; a < agents.size(); ++a) { push_goal_clause(t, a); }
+	}
+}
+
+/*
+	As without replanning, the nodes of the previous time step and their neighbours, except the ones which can't reach
+	the goal. The agents which left get no more variables, the movement clauses of their last time step force them
+	out of the graph
+*/
+void Replanner::create_agent_variables(std::size_t t, std::size_t a) {
+	if (!active[a] || t < arrivals[a])
+		return;
+
+	std::vector<node_t> nodes;
+	if (t == arrivals[a]) {
+		nodes.push_back(agents[a].initial);
+	} else {
+		for (auto v : context.nodes_at(t - 1, a)) {
+			nodes.push_back(v);
+			for (auto u : graph.neighbours_of(v)) { nodes.push_back(u); }
+		}
+		std::sort(std::begin(nodes), std::end(nodes));
+		nodes.erase(std::unique(std::begin(nodes), std::end(nodes)), std::end(nodes));
+	}
+
+	for (auto v : nodes) {
+		auto distance = mdds[a].distance_to_goal(v);
+		if (distance == UNREACHABLE)
+			continue;
+
+		context.create_var(t, a, v);
+		if (distance > 0) {
+			push_distance_guard(t, a, v, distance);
+		}
+	}
+}
+
+// Goal, B(t) and S(a) => X(t, a, goal)
+void Replanner::push_goal_clause(std::size_t t, std::size_t a) {
+	if (!active[a])
+		return;
+
+	auto goal	  = agents[a].goal;
+	auto bound	  = !context.makespan_bound(t);
+	Clause clause = bound | !selectors[a];
+	if (context.contains(t, a, goal)) {
+		clause |= context.get_var(t, a, goal);
+	}
+	context.push(clause);
+}
+
+/*
+	Distances to the goal on the existing time steps, the ones which didn't grow since `previous_mdd` (if any) are
+	already encoded
+*/
+void Replanner::push_distance_guards(std::size_t a, MDD const* previous_mdd) {
+	for (auto t = arrivals[a]; t < next_time_step; ++t) {
+		for (auto v : context.nodes_at(t, a)) {
+			auto distance = mdds[a].distance_to_goal(v);
+			if (distance == 0 || (previous_mdd && distance <= previous_mdd->distance_to_goal(v)))
+				continue;
+
+			push_distance_guard(t, a, v, distance);
+		}
+	}
+}
+
+/*
+	S(a) => !X(t, a, v) until the makespan is large enough for the distance of v to the goal, !B(t + distance - 1),
+	or for good when v can't reach the goal
+*/
+void Replanner::push_distance_guard(std::size_t t, std::size_t a, node_t v, std::size_t distance) {
+	auto selector = !selectors[a];
+	Clause clause = selector | !context.get_var(t, a, v);
+	if (distance != UNREACHABLE) {
+		clause |= !context.makespan_bound(t + distance - 1);
+	}
+	context.push(clause);
+}
+
+void Replanner::advance(std::size_t elapsed) {
+	if (elapsed == 0)
+		return;
+
+	for (std::size_t a = 0; a < agents.size(); ++a) {
+		auto& path = last_plan[a];
+		if (!active[a] || path.empty())
+			continue;
+
+		auto done		  = std::min(elapsed, path.size() - 1);
+		agents[a].initial = path[done];
+		path.erase(std::begin(path), std::begin(path) + static_cast<std::ptrdiff_t>(done));
+	}
+
+	// Before the first plan, the instance itself starts later
+	if (encoded()) {
+		origin += elapsed;
+	}
+}
+
+void Replanner::remove_agent(std::size_t a) {
+	check_agent(a);
+	active[a] = false;
+	last_plan[a].clear();
+	if (encoded()) {
+		context.push(!selectors[a]);
+	}
+}
+
+void Replanner::change_goal(std::size_t a, node_t goal) {
+	check_agent(a);
+	check_node(goal);
+	agents[a].goal = goal;
+	mdds[a]		   = MDD(*oracle, agents[a]);
+	if (!encoded())
+		return;
+
+	context.push(!selectors[a]);
+	selectors[a] = context.create_aux_var();
+	push_distance_guards(a, nullptr);
+	for (std::size_t t = 0; t < next_time_step; ++t) { push_goal_clause(t, a); }
+}
+
+void Replanner::add_agent(Agent const& agent) {
+	check_node(agent.initial);
+	check_node(agent.goal);
+
+	auto a = agents.size();
+	agents.push_back(agent);
+	mdds.emplace_back(*oracle, agent);
+	active.push_back(true);
+	arrivals.push_back(encoded() ? origin : 0);
+	last_plan.emplace_back();
+	if (!encoded())
+		return;
+
+	context.add_agent();
+	selectors.push_back(context.create_aux_var());
+	for (auto t = origin; t < next_time_step; ++t) { create_agent_variables(t, a); }
+	for (auto t = origin; t < next_time_step; ++t) { context.index_agents(t); }
+
+	ClauseShard shard;
+	for (auto t = origin; t < next_time_step; ++t) {
+		if (t + 1 < next_time_step) {
+			push_movement_clauses(context, shard, graph, t, a, a + 1);
+		}
+		push_single_position_clauses(context, shard, t, a, a + 1, amo_encoding);
+		push_agent_conflict_clauses(context, shard, graph, t, a);
+	}
+	context.merge(shard);
+
+	for (std::size_t t = 0; t < next_time_step; ++t) { push_goal_clause(t, a); }
+}
+
+void Replanner::block_edges(std::vector<edge_t> edges) {
+	for (auto& edge : edges) {
+		check_node(edge.first);
+		check_node(edge.second);
+		edge = sorted(edge);
+	}
+	std::sort(std::begin(edges), std::end(edges));
+	edges.erase(std::unique(std::begin(edges), std::end(edges)), std::end(edges));
+
+	// The existing movement clauses allow the moves along the edges, forbid them
+	for (auto const& edge : edges) {
+		for (std::size_t t = 0; t + 1 < next_time_step; ++t) {
+			for (std::size_t a = 0; a < agents.size(); ++a) {
+				for (auto from : { edge.first, edge.second }) {
+					auto to = from == edge.first ? edge.second : edge.first;
+					if (context.contains(t, a, from) && context.contains(t + 1, a, to)) {
+						auto x0 = !context.get_var(t, a, from);
+						auto x1 = !context.get_var(t + 1, a, to);
+						context.push(x0 | x1);
+					}
+				}
+			}
+		}
+	}
+
+	// The next time steps are generated from the graph without them
+	std::vector<edge_t> kept;
+	for (node_t v = 0; v < graph.size(); ++v) {
+		for (auto u : graph.neighbours_of(v)) {
+			edge_t edge(v, u);
+			if (v <= u && !std::binary_search(std::begin(edges), std::end(edges), edge)) {
+				kept.push_back(edge);
+			}
+		}
+	}
+	graph  = Graph(graph.size(), std::move(kept));
+	oracle = std::make_shared<DistanceOracle>(graph);
+
+	// Removing an edge only changes the distances to the goal when it's on a shortest path to the goal, i.e. its
+	// nodes are one step apart
+	for (std::size_t a = 0; a < agents.size(); ++a) {
+		if (!active[a])
+			continue;
+
+		auto affected = std::any_of(std::begin(edges), std::end(edges), [&](edge_t const& edge) {
+			auto d0 = mdds[a].distance_to_goal(edge.first);
+			auto d1 = mdds[a].distance_to_goal(edge.second);
+			return d0 != UNREACHABLE && d1 != UNREACHABLE && (d0 == d1 + 1 || d1 == d0 + 1);
+		});
+		if (!affected)
+			continue;
+
+		auto previous_mdd = std::move(mdds[a]);
+		mdds[a]			  = MDD(*oracle, agents[a]);
+		if (encoded()) {
+			push_distance_guards(a, &previous_mdd);
+		}
+	}
+}
+
+void Replanner::check_agent(std::size_t a) const {
+	if (a >= agents.size() || !active[a]) {
+		throw std::runtime_error("No agent " + std::to_string(a));
+	}
+}
+
+void Replanner::check_node(node_t node) const {
+	if (node >= graph.size()) {
+		throw std::runtime_error("No node " + std::to_string(node));
+	}
+}
+
+} // namespace cpf
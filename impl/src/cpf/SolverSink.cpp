@@ -0,0 +1,18 @@
+#include <cpf/SolverSink.hpp>
+
+namespace cpf {
+
+SolverSink::SolverSink(Glucose::SimpSolver& solver_) noexcept : solver{ &solver_ } {}
+
+void SolverSink::add_clause(Variable const* first, Variable const* last) {
+	buffer.clear();
+	for (; first != last; ++first) { buffer.push(to_lit(*first)); }
+	solver->addClause(buffer);
+}
+
+Glucose::Lit SolverSink::to_lit(Variable const& var) {
+	while (var.id >= solver->nVars()) { solver->newVar(); }
+	return Glucose::mkLit(var.id, var.negated);
+}
+
+} // namespace cpf
@@ -0,0 +1,144 @@
+#include <cpf/SpeculativeSearch.hpp>
+
+#include <cpf/MakespanSolver.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace cpf {
+
+namespace {
+
+/*
+	A makespan solved on its own thread by the speculative search, `result` and `res` are written by the thread before
+	it sets `finished`, under the search's mutex
+*/
+struct SpeculativeJob {
+	explicit SpeculativeJob(Interruption& interruption_) : solver{ interruption_ } {}
+
+	int makespan;
+	MakespanSolver solver;
+	std::thread thread;
+	std::chrono::steady_clock::time_point begin;
+
+	bool finished		  = false;
+	Glucose::lbool result = l_Undef;
+	std::vector<bool> res;
+};
+
+/*
+	How often the speculative search checks for an interruption while its jobs are running
+*/
+constexpr std::chrono::milliseconds SPECULATIVE_POLL_INTERVAL(100);
+
+} // namespace
+
+bool speculative_search(
+	Context& context,
+	ClauseArena const& arena,
+	std::function<bool(int)> const& extend_up_to,
+	std::pair<int, int> makespan_interval,
+	std::size_t window,
+	std::vector<std::vector<node_t>> const& hints,
+	Interruption& interruption,
+	int& makespan,
+	std::vector<bool>& res) {
+	std::mutex mutex;
+	std::condition_variable job_finished;
+	std::vector<std::unique_ptr<SpeculativeJob>> jobs;
+
+	bool found = false;
+	int next   = makespan_interval.first;
+	for (;;) {
+		while (!interruption.requested() && jobs.size() < window && next <= makespan_interval.second
+			   && !(found && next >= makespan)) {
+			auto m = next++;
+			std::cout << "Generating SAT problem with a bounded makespan of " << m << "...\n";
+			auto clock_begin = std::chrono::steady_clock::now();
+			if (!extend_up_to(m))
+				continue;
+
+			std::cout << "\t#Variables: " << context.variables_count() << '\n';
+			std::cout << "\t#Clauses: " << context.clauses_count() << '\n';
+			{
+				std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - clock_begin;
+				std::cout << "\tGenerated in " << duration.count() << "ms\n";
+			}
+
+			std::unique_ptr<SpeculativeJob> job(new SpeculativeJob(interruption));
+			job->makespan = m;
+			job->begin	  = clock_begin;
+			load_makespan(job->solver, context, arena, static_cast<std::size_t>(m), hints);
+
+			std::cout << "\tSolving on its own thread...\n";
+			auto raw	= job.get();
+			raw->thread = std::thread([raw, &mutex, &job_finished]() {
+				std::vector<bool> model;
+				auto result = raw->solver.solve_limited(model);
+
+				std::lock_guard<std::mutex> lock(mutex);
+				raw->result	  = result;
+				raw->res	  = std::move(model);
+				raw->finished = true;
+				job_finished.notify_one();
+			});
+			jobs.push_back(std::move(job));
+		}
+
+		if (jobs.empty())
+			break;
+
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			job_finished.wait_for(lock, SPECULATIVE_POLL_INTERVAL, [&]() {
+				for (auto const& job : jobs) {
+					if (job->finished)
+						return true;
+				}
+				return false;
+			});
+		}
+
+		if (interruption.requested()) {
+			for (auto& job : jobs) { job->solver.solver.interrupt(); }
+		}
+
+		for (auto it = std::begin(jobs); it != std::end(jobs);) {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!(*it)->finished) {
+					++it;
+					continue;
+				}
+			}
+
+			auto& job = **it;
+			job.thread.join();
+
+			std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - job.begin;
+			auto status = job.result == l_True ? "solved" : job.result == l_False ? "no solution" : "cancelled";
+			std::cout << "Makespan " << job.makespan << ": " << status << " in " << duration.count() << "ms\n";
+
+			if (job.result == l_True && (!found || job.makespan < makespan)) {
+				found	 = true;
+				makespan = job.makespan;
+				res		 = std::move(job.res);
+				for (auto& other : jobs) {
+					if (other->makespan > makespan) {
+						other->solver.solver.interrupt();
+					}
+				}
+			}
+
+			it = jobs.erase(it);
+		}
+	}
+
+	return found;
+}
+
+} // namespace cpf
@@ -0,0 +1,155 @@
+#include <cpf/SumOfCosts.hpp>
+
+#include <cpf/LazyConflicts.hpp>
+#include <cpf/Totalizer.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+namespace cpf {
+
+namespace {
+
+/*
+	Time at which agent `a` reaches its goal for good in the model `res` of a plan of `makespan`
+*/
+std::size_t agent_cost(
+	Context const& context,
+	Agent const& agent,
+	std::size_t a,
+	std::size_t makespan,
+	std::vector<bool> const& res) {
+	auto cost = makespan;
+	while (cost > 0 && context.contains(cost - 1, a, agent.goal)
+		   && res[static_cast<std::size_t>(context.get_var(cost - 1, a, agent.goal).id)]) {
+		--cost;
+	}
+	return cost;
+}
+
+std::size_t sum_of_costs(
+	Context const& context,
+	std::vector<Agent> const& agents,
+	std::size_t makespan,
+	std::vector<bool> const& res) {
+	std::size_t sum = 0;
+	for (std::size_t a = 0; a < agents.size(); ++a) { sum += agent_cost(context, agents[a], a, makespan, res); }
+	return sum;
+}
+
+/*
+	Variables F(t, a), agent a stays at its goal from t to `makespan`, so the cost of a is at most the number of time
+	steps t < makespan where F(t, a) is false
+	Return the literals !F(t, a) for the time steps from which the agents can be at their goal, the earlier time steps
+	always count and are summed in `fixed_cost`
+*/
+std::vector<Variable> push_unfinished_literals(
+	Context& context,
+	std::vector<Agent> const& agents,
+	std::vector<LayeredMDD> const& mdds,
+	std::size_t makespan,
+	std::size_t& fixed_cost) {
+	std::vector<Variable> unfinished;
+	fixed_cost = 0;
+	for (std::size_t a = 0; a < agents.size(); ++a) {
+		auto goal  = agents[a].goal;
+		auto first = mdds[a].distance_to_goal(agents[a].initial);
+		fixed_cost += first;
+
+		// F(t, a) => X(t, a, goal) and F(t, a) => F(t+1, a)
+		Variable later;
+		for (auto t = makespan + 1; t-- > first;) {
+			assert(context.contains(t, a, goal));
+			auto finished	= context.create_aux_var();
+			auto unfinished_t = !finished;
+			context.push(unfinished_t | context.get_var(t, a, goal));
+			if (t < makespan) {
+				context.push(unfinished_t | later);
+				unfinished.push_back(unfinished_t);
+			}
+			later = finished;
+		}
+	}
+	return unfinished;
+}
+
+} // namespace
+
+std::size_t minimise_sum_of_costs(
+	Context& context,
+	Graph const& graph,
+	std::vector<Agent> const& agents,
+	std::vector<LayeredMDD> const& mdds,
+	std::size_t makespan,
+	IncrementalSolver* incremental_solver,
+	ClauseArena const& arena,
+	std::vector<std::vector<node_t>> const& plan_paths,
+	AtMostOneEncoding amo_encoding,
+	bool lazy_conflicts,
+	Interruption& interruption,
+	std::vector<bool>& res) {
+	std::size_t fixed_cost = 0;
+	auto unfinished		   = push_unfinished_literals(context, agents, mdds, makespan, fixed_cost);
+
+	auto cost = sum_of_costs(context, agents, makespan, res);
+	std::cout << "Sum of costs: " << cost << " (lower bound: " << fixed_cost << ")\n";
+	if (cost == fixed_cost)
+		return cost;
+
+	// Only the counts below the cost of the current plan are ever bounded
+	auto at_least = push_totalizer(
+		context, unfinished.data(), unfinished.data() + unfinished.size(), cost - fixed_cost);
+	std::cout << "\t#Variables: " << context.variables_count() << '\n';
+	std::cout << "\t#Clauses: " << context.clauses_count() << '\n';
+
+	// Without the incremental mode, a solver is given the clauses of this makespan only
+	std::vector<Variable> assumptions;
+	std::unique_ptr<IncrementalSolver> makespan_solver;
+	if (incremental_solver) {
+		assumptions.push_back(context.makespan_bound(makespan));
+	} else {
+		makespan_solver.reset(new IncrementalSolver(interruption));
+		// The plan found is the best hint for the cheaper ones
+		load_makespan(*makespan_solver, context, arena, makespan, plan_paths);
+		incremental_solver = makespan_solver.get();
+	}
+	assumptions.emplace_back();
+
+	std::vector<bool> model;
+	while (cost > fixed_cost) {
+		auto clock_begin = std::chrono::steady_clock::now();
+		// At most cost - fixed_cost - 1 unfinished time steps
+		assumptions.back() = !at_least[cost - fixed_cost - 1];
+		Glucose::lbool ret;
+		if (lazy_conflicts) {
+			ret = solve_lazily(
+				*incremental_solver,
+				context,
+				graph,
+				agents.size(),
+				makespan,
+				amo_encoding,
+				assumptions,
+				model);
+		} else {
+			ret = incremental_solver->solve_assuming(assumptions, model);
+		}
+
+		std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - clock_begin;
+		if (ret != l_True) {
+			if (ret == l_False) {
+				std::cout << "\tNo cheaper plan, took " << duration.count() << "ms\n";
+			}
+			break;
+		}
+
+		cost = sum_of_costs(context, agents, makespan, model);
+		res	 = std::move(model);
+		std::cout << "Sum of costs: " << cost << ", took " << duration.count() << "ms\n";
+	}
+	return cost;
+}
+
+} // namespace cpf
@@ -0,0 +1,91 @@
+#include <cpf/ThreadPool.hpp>
+
+namespace cpf {
+
+ThreadPool::ThreadPool(std::size_t thread_count) {
+	for (std::size_t i = 1; i < thread_count; ++i) {
+		workers.emplace_back([this]() { work(); });
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake_up.notify_all();
+	for (auto& worker : workers) { worker.join(); }
+}
+
+std::size_t ThreadPool::size() const noexcept {
+	return workers.size() + 1;
+}
+
+void ThreadPool::run(std::size_t count, std::function<void(std::size_t)> const& task) {
+	if (workers.empty()) {
+		for (std::size_t i = 0; i < count; ++i) { task(i); }
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		current_task  = &task;
+		current_count = count;
+		next_index	  = 0;
+		busy_workers  = workers.size();
+		++generation;
+	}
+	wake_up.notify_all();
+
+	work_on_current();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [this]() { return busy_workers == 0; });
+	current_task = nullptr;
+	if (error) {
+		auto e = error;
+		error  = nullptr;
+		std::rethrow_exception(e);
+	}
+}
+
+void ThreadPool::work() {
+	std::size_t seen_generation = 0;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake_up.wait(lock, [&]() { return stopping || generation != seen_generation; });
+			if (stopping)
+				return;
+			seen_generation = generation;
+		}
+
+		work_on_current();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (--busy_workers == 0) {
+			done.notify_one();
+		}
+	}
+}
+
+void ThreadPool::work_on_current() {
+	for (;;) {
+		auto i = next_index++;
+		if (i >= current_count)
+			return;
+
+		try {
+			(*current_task)(i);
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!error) {
+				error = std::current_exception();
+			}
+			// Don't start the remaining iterations
+			next_index = current_count;
+		}
+	}
+}
+
+} // namespace cpf
@@ -0,0 +1,40 @@
+#include <cpf/Totalizer.hpp>
+
+#include <algorithm>
+
+namespace cpf {
+
+std::vector<Variable> push_totalizer(
+	Context& context, Variable const* first, Variable const* last, std::size_t max_count) {
+	auto n = static_cast<std::size_t>(last - first);
+	if (n <= 1 || max_count == 0)
+		return std::vector<Variable>(first, first + std::min(n, max_count));
+
+	auto middle = first + n / 2;
+	auto left	= push_totalizer(context, first, middle, max_count);
+	auto right	= push_totalizer(context, middle, last, max_count);
+
+	std::vector<Variable> outputs(std::min(n, max_count));
+	for (auto& output : outputs) { output = context.create_aux_var(); }
+
+	// At least i inputs on the left and j on the right, at least i+j inputs in total
+	for (std::size_t i = 0; i <= left.size(); ++i) {
+		for (std::size_t j = 0; j <= right.size(); ++j) {
+			if (i + j == 0)
+				continue;
+
+			Clause clause = outputs[std::min(i + j, outputs.size()) - 1];
+			if (i > 0) {
+				clause |= !left[i - 1];
+			}
+			if (j > 0) {
+				clause |= !right[j - 1];
+			}
+			context.push(clause);
+		}
+	}
+
+	return outputs;
+}
+
+} // namespace cpf
@@ -135,7 +135,7 @@ int main(int argc, char** argv) {
 
 	std::vector<bool> is_wall(static_cast<std::size_t>(nodes_count));
 	std::vector<cpf::Agent> agents(static_cast<std::size_t>(agent_count));
-	cpf::Graph graph(static_cast<std::size_t>(nodes_count));
+	std::vector<cpf::edge_t> edges;
 
 	{
 		std::mt19937 eng(std::random_device{}());
@@ -167,33 +167,35 @@ int main(int argc, char** argv) {
 			if (y > 0) {
 				auto neighbour = x + (y - 1) * size;
 				if (!is_wall[neighbour]) {
-					graph[{ node, neighbour }] = true;
+					edges.emplace_back(node, neighbour);
 				}
 			}
 
 			if (y < static_cast<std::size_t>(size) - 1) {
 				auto neighbour = x + (y + 1) * size;
 				if (!is_wall[neighbour]) {
-					graph[{ node, neighbour }] = true;
+					edges.emplace_back(node, neighbour);
 				}
 			}
 
 			if (x > 0) {
 				auto neighbour = x - 1 + y * size;
 				if (!is_wall[neighbour]) {
-					graph[{ node, neighbour }] = true;
+					edges.emplace_back(node, neighbour);
 				}
 			}
 
 			if (x < static_cast<std::size_t>(size) - 1) {
 				auto neighbour = x + 1 + y * size;
 				if (!is_wall[neighbour]) {
-					graph[{ node, neighbour }] = true;
+					edges.emplace_back(node, neighbour);
 				}
 			}
 		}
 	}
 
+	cpf::Graph graph(static_cast<std::size_t>(nodes_count), std::move(edges));
+
 	// Display the grid if requested
 	if (display_stream != nullptr) {
 		std::unordered_map<std::size_t, std::size_t> agents_initial;
@@ -3,13 +3,16 @@
 #include <signal.h>
 #include <sys/resource.h>
 
-#include <cassert>
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <optional>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <glucose-syrup-4.1/core/Dimacs.h>
@@ -19,26 +22,36 @@
 #include <glucose-syrup-4.1/utils/System.h>
 
 #include <cpf/Agent.hpp>
-#include <cpf/Clause.hpp>
+#include <cpf/AtMostOne.hpp>
 #include <cpf/CmdArg.hpp>
-#include <cpf/Context.hpp>
+#include <cpf/DistanceOracle.hpp>
+#include <cpf/Feasibility.hpp>
 #include <cpf/FileSerializer.hpp>
 #include <cpf/Graph.hpp>
-#include <cpf/MDD.hpp>
-#include <cpf/Variable.hpp>
+#include <cpf/Interruption.hpp>
+#include <cpf/MakespanSearch.hpp>
+#include <cpf/Planner.hpp>
+#include <cpf/PlanningService.hpp>
+#include <cpf/PrioritizedPlanner.hpp>
+#include <cpf/Replanner.hpp>
+#include <cpf/ThreadPool.hpp>
 
 //=================================================================================================
-Glucose::Solver* current_global_solver = nullptr;
-bool interrupted					   = false;
+// Requested by the signal handlers, checked by the search and its solving threads
+cpf::Interruption interruption;
+cpf::Replanner* current_global_replanner = nullptr;
 // Terminate by notifying the solver and back out gracefully. This is mainly to have a test-case
 // for this feature of the Solver as it may take longer than an immediate call to '_exit()'.
 void SIGINT_interrupt(int) {
 	// Try to interrupt softly the solver
 	std::cout << "Interrupt!\n";
-	interrupted = true;
-	if (current_global_solver) {
+	bool solver_interrupted = interruption.interrupt();
+	if (current_global_replanner) {
+		current_global_replanner->interrupt();
+		solver_interrupted = true;
+	}
+	if (solver_interrupted) {
 		std::cout << "Interrupt Solver!\n";
-		current_global_solver->interrupt();
 	}
 }
 
@@ -74,73 +87,82 @@ void init_glucose(int cpu_lim) {
 	}
 }
 
-bool solve(cpf::Context const& context, std::vector<bool>& res) {
-	// Setup glucose's SAT solver
-	Glucose::SimpSolver solver;
-
-	solver.parsing			  = 1;
-	solver.use_simplification = true;
-
-	solver.verbosity		  = -1;
-	solver.verbEveryConflicts = 10000;
-	solver.showModel		  = true;
-
-	solver.certifiedUNSAT = false;
-	solver.vbyte		  = false;
-
-	for (auto const& clause : context) {
-		Glucose::vec<Glucose::Lit> glucose_clause;
-		glucose_clause.capacity(clause.variables.size());
-		for (auto const& var : clause.variables) {
-			while (var.id >= solver.nVars()) { solver.newVar(); }
-
-			// Push each clauses
-			glucose_clause.push(Glucose::mkLit(var.id, var.negated));
-
-			if (interrupted)
-				return false;
-		}
-		solver.addClause(glucose_clause);
-	}
-
-	solver.parsing = 0;
-	solver.eliminate(true);
-	if (!solver.okay()) {
-		return false;
-	}
-
-	if (interrupted)
-		return false;
-
-	current_global_solver = &solver;
-	bool ret			  = solver.solve();
-	if (!ret) {
-		return false;
-	}
-
-	current_global_solver = nullptr;
-
-	auto const nvars = static_cast<std::size_t>(solver.nVars());
-	std::vector<bool> values(nvars);
-	for (std::size_t i = 0; i < nvars; ++i) { values[i] = solver.model[i] == l_True; }
-
-	res = std::move(values);
-	return true;
-}
-
 void print_help(char const* prog_name) {
 	std::cerr << "Usage: " << prog_name << " <options> --input=<file>\n";
+	std::cerr << "       " << prog_name << " <options> --serve\n";
 	std::cerr << "\t--input=<file>         File in CPF format [REQUIRED]\n";
 	std::cerr << "Options:\n";
 	std::cerr << "\t--min-makespan=<value> Minimum makespan researched\n";
 	std::cerr << "\t--max-makespan=<value> Maximum makespan researched\n";
 	std::cerr << "\t--max-time=<value>     Maximum amount of seconds to solve the CPF\n";
-	std::cerr << "\t--trust                Don't verify that a solution exists (Doesn't do anything)\n";
+	std::cerr << "\t--trust                Don't check in polynomial time whether a solution may exist, nor look for a "
+				 "first plan bounding the makespan\n";
 	std::cerr << "\t--no-mdd               Don't reduce search space\n";
+	std::cerr << "\t--incremental          Keep the same SAT solver (and what it learnt) across the makespans\n";
+	std::cerr << "\t--amo=<encoding>       Encoding of the \"at most one node per agent\" and \"at most one agent per "
+				 "node\" constraints: pairwise, sequential, commander, product or auto [DEFAULT: auto]\n";
+	std::cerr << "\t--search=<strategy>    Order of the makespans tried from the lower bound: linear, exponential (the "
+				 "step doubles, then a binary search) or geometric (the makespan grows by half, then a binary search) "
+				 "[DEFAULT: linear]\n";
+	std::cerr << "\t--threads=<value>      Solve each makespan with glucose-syrup's portfolio of <value> solvers "
+				 "sharing their learnt clauses, can't be used with --incremental [DEFAULT: 1, the sequential solver]\n";
+	std::cerr << "\t--speculative=<value>  Solve up to <value> consecutive makespans at once, each on its own thread, "
+				 "the smallest solvable one is still the one found [DEFAULT: 1]\n";
+	std::cerr << "\t--generation-threads=<value> Threads generating the clauses, the clauses don't depend on it "
+				 "[DEFAULT: number of cores]\n";
+	std::cerr << "\t--objective=<value>    What is minimised: makespan, or soc to then lower the sum of the times at "
+				 "which the agents reach their goal for good, without changing the makespan [DEFAULT: makespan]\n";
+	std::cerr << "\t--lazy                 Leave out the vertex and swap conflict clauses, only add the ones violated "
+				 "by the plans found and solve again, requires --incremental\n";
+	std::cerr << "\t--pairwise-pruning     Before solving each makespan, forbid the nodes of each agent on no "
+				 "conflict-free pair of paths with another agent, can't be used with --no-mdd\n";
+	std::cerr << "\t--independence         Plan the agents alone, then merge the groups of colliding agents and plan "
+				 "them again until no paths collide, each group being a smaller SAT problem\n";
+	std::cerr << "\t--no-hints             Don't make the solver try the shortest path of each agent first\n";
+	std::cerr << "\t--hint=<file>          Make the solver try the paths of <file> first (a previous plan, in the "
+				 "format of --output) instead of the shortest ones\n";
+	std::cerr << "\t--replan=<file>        Plan again after the changes of --delta: the instance is planned with the "
+				 "plan of <file> (in the format of --output) as a hint, then the same solver plans the changed "
+				 "instance, only --amo and --max-makespan apply\n";
+	std::cerr << "\t--delta=<file>         Changes for --replan, one per line: elapsed <time steps>, remove <agent>, "
+				 "goal <agent> <node>, add <initial> <goal>, block <node> <node> or obstacle <node>\n";
+	std::cerr << "\t--replanned-input=<file> Write the instance once the changes of --delta are applied, in CPF "
+				 "format\n";
+	std::cerr << "\t--serve                Instead of --input, answer the planning requests of the standard input "
+				 "on the standard output until it's closed: each request is a CPF instance between the lines "
+				 "\"solve <id>\" and \"end\", each answer the line \"plan <id> solved <makespan>\" (or "
+				 "\"plan <id> no-solution\", \"plan <id> error <message>\"), the paths in the format of --output and "
+				 "the line \"end\". Only --amo and --max-makespan apply\n";
+	std::cerr << "\t--distances=<file>     Read the distances between nodes from <file> if it was written for the same "
+				 "graph, and write there the ones computed, to be reused by the next runs on this graph\n";
+	std::cerr << "\t--all-distances        Compute the distances between all the nodes before planning, e.g. to write "
+				 "them all with --distances. They take 2 bytes per pair of nodes (4 when the graph's diameter exceeds "
+				 "65534), about 5GB in memory and on disk for 50000 nodes\n";
+	std::cerr << "\t--workers=<value>      Requests solved at once by --serve [DEFAULT: number of cores]\n";
 	std::cerr << "\t--output=<file>        Write path of all agents to <file>, each line is a path, each path is a "
 				 "sequence of number representing nodes\n";
 }
 
+/*
+	Beyond this size of the distances between all the nodes, --all-distances warns about it
+*/
+constexpr std::size_t ALL_DISTANCES_WARNING_SIZE = std::size_t(1) << 30;
+
+/*
+	Paths written by --output, one line per agent
+*/
+std::vector<std::vector<cpf::node_t>> read_paths(std::istream& is) {
+	std::vector<std::vector<cpf::node_t>> paths;
+	std::string line;
+	while (std::getline(is, line)) {
+		std::stringstream ss(line);
+		paths.emplace_back();
+		cpf::node_t node;
+		while (ss >> node) { paths.back().push_back(node); }
+	}
+	return paths;
+}
+
 int get_max_cpu_from_args(cpf::CmdArgMap const& args) {
 	long o;
 	if (cpf::get_argument_as_long(args, "max-time", o)) {
@@ -168,172 +190,235 @@ int get_max_makespan(cpf::CmdArgMap const& args) {
 	}
 }
 
-bool build_context(
-	cpf::Context& context,
-	cpf::Graph const& graph,
-	std::vector<cpf::Agent> const& agents,
-	std::size_t makespan,
-	std::vector<cpf::MDD>* mdds) {
-	context = cpf::Context(makespan, agents.size(), graph.size());
+bool get_amo_encoding(cpf::CmdArgMap const& args, cpf::AtMostOneEncoding& out) {
+	std::string o;
+	if (cpf::get_argument_as_string(args, "amo", o)) {
+		return cpf::parse_at_most_one_encoding(o, out);
+	} else {
+		out = cpf::AtMostOneEncoding::Auto;
+		return true;
+	}
+}
 
-	// Construct the mdds
-	if (mdds) {
-		for (auto& mdd : *mdds) { mdd.step_until(makespan); }
+bool get_search_strategy(cpf::CmdArgMap const& args, cpf::SearchStrategy& out) {
+	std::string o;
+	if (cpf::get_argument_as_string(args, "search", o)) {
+		return cpf::parse_search_strategy(o, out);
+	} else {
+		out = cpf::SearchStrategy::Linear;
+		return true;
 	}
+}
 
-	// Create the context, and fill it with the clauses
+bool get_objective(cpf::CmdArgMap const& args, cpf::Objective& out) {
+	std::string o;
+	if (!cpf::get_argument_as_string(args, "objective", o)) {
+		out = cpf::Objective::Makespan;
+		return true;
+	}
 
-	for (std::size_t a = 0; a < agents.size(); ++a) {
-		bool has_variable = false;
-		for (std::size_t t = 0; t <= makespan; ++t) {
-			for (std::size_t v = 0; v < graph.size(); ++v) {
-				if (!mdds || (*mdds)[a].accessible(v, t, makespan)) {
-					context.create_var(t, a, v);
-					has_variable = true;
-				}
-			}
-		}
+	if (o == "makespan") {
+		out = cpf::Objective::Makespan;
+	} else if (o == "soc") {
+		out = cpf::Objective::SumOfCosts;
+	} else {
+		return false;
+	}
+	return true;
+}
 
-		// If an agent has no path, no solution could exist, early exit
-		if (!has_variable) {
-			std::cout << "\tNo path for agent " << a << " found in the MDD\n";
-			return false;
-		}
+int get_solver_threads(cpf::CmdArgMap const& args) {
+	long o;
+	if (cpf::get_argument_as_long(args, "threads", o)) {
+		return static_cast<int>(o < 1l ? 1l : o);
+	} else {
+		return 1;
 	}
+}
 
-	// Clause #1
-	// !X(t, a, v) or X(t+1, a, v) or OR(u, u -> v exists) X(t+1, a, u)
-	for (std::size_t a = 0; a < agents.size(); ++a) {
-		for (std::size_t t = 0; t < makespan; ++t) {
-			for (std::size_t v = 0; v < graph.size(); ++v) {
-				if (context.contains(t, a, v)) {
-					auto x0			   = !context.get_var(t, a, v);
-					cpf::Clause clause = x0;
-					for (std::size_t u = 0; u < graph.size(); ++u) {
-						if (u == v || graph[{ v, u }]) {
-							if (context.contains(t + 1, a, u)) {
-								clause |= context.get_var(t + 1, a, u);
-							}
-						}
-					}
-					context.push(clause);
-				}
-			}
-		}
+std::size_t get_speculative_window(cpf::CmdArgMap const& args) {
+	long o;
+	if (cpf::get_argument_as_long(args, "speculative", o)) {
+		return static_cast<std::size_t>(o < 1l ? 1l : o);
+	} else {
+		return 1;
 	}
+}
 
-	// Clause #2
-	// !X(t, a, v) or !X(t, b, v)
-	for (std::size_t a = 0; a < agents.size(); ++a) {
-		for (std::size_t b = 0; b < agents.size(); ++b) {
-			if (b == a)
-				continue;
-
-			for (std::size_t t = 0; t <= makespan; ++t) {
-				for (std::size_t v = 0; v < graph.size(); ++v) {
-					if (context.contains(t, a, v) && context.contains(t, b, v)) {
-						auto x0 = !context.get_var(t, a, v);
-						auto x1 = !context.get_var(t, b, v);
-						context.push(x0 | x1);
-					}
-				}
-			}
-		}
+std::size_t get_generation_threads(cpf::CmdArgMap const& args) {
+	long o;
+	if (cpf::get_argument_as_long(args, "generation-threads", o)) {
+		return static_cast<std::size_t>(o < 1l ? 1l : o);
+	} else {
+		return std::max(1u, std::thread::hardware_concurrency());
 	}
+}
 
-	// Clause #3
-	// !X(t, a, v) or !X(t, a, u)
-	for (std::size_t a = 0; a < agents.size(); ++a) {
-		for (std::size_t t = 0; t <= makespan; ++t) {
-			for (std::size_t v = 0; v < graph.size(); ++v) {
-				for (std::size_t u = 0; u < graph.size(); ++u) {
-					if (u == v)
-						continue;
-					if (context.contains(t, a, v) && context.contains(t, a, u)) {
-						auto x0 = !context.get_var(t, a, v);
-						auto x1 = !context.get_var(t, a, u);
-						context.push(x0 | x1);
-					}
-				}
-			}
-		}
+std::size_t get_workers(cpf::CmdArgMap const& args) {
+	long o;
+	if (cpf::get_argument_as_long(args, "workers", o)) {
+		return static_cast<std::size_t>(o < 1l ? 1l : o);
+	} else {
+		return std::max(1u, std::thread::hardware_concurrency());
 	}
+}
 
-	// Clause #4
-	// !X(t, a, v) or !X(t+1, a, u) or !X(t, b, u) or !X(t+1, b, v)
-	for (std::size_t a = 0; a < agents.size(); ++a) {
-		for (std::size_t b = 0; b < agents.size(); ++b) {
-			if (a == b)
-				continue;
-
-			for (std::size_t t = 0; t < makespan; ++t) {
-				for (std::size_t v = 0; v < graph.size(); ++v) {
-					for (std::size_t u = 0; u < graph.size(); ++u) {
-						if (u == v)
-							continue;
-						if (!graph[{ v, u }])
-							continue;
-
-						if (context.contains(t, a, v) && context.contains(t + 1, a, u) && context.contains(t, b, u)
-							&& context.contains(t + 1, b, v)) {
-							auto x0 = !context.get_var(t, a, v);
-							auto x1 = !context.get_var(t + 1, a, u);
-							auto x2 = !context.get_var(t, b, u);
-							auto x3 = !context.get_var(t + 1, b, v);
-							context.push(x0 | x1 | x2 | x3);
-						}
-					}
-				}
-			}
-		}
+/*
+	Write the paths in the format of --output, false when the file can't be opened
+*/
+bool write_paths(std::string const& filename, std::vector<std::vector<cpf::node_t>> const& paths) {
+	std::ofstream file(filename);
+	if (!file) {
+		std::cerr << "Couldn't open output file '" << filename << "'\n";
+		return false;
 	}
+	std::cout << "Writing to '" << filename << "'... ";
 
-	std::vector<std::size_t> initial_nodes_with_agents(graph.size(), agents.size());
-	std::vector<std::size_t> goal_nodes_with_agents(graph.size(), agents.size());
+	for (auto const& path : paths) {
+		for (auto v : path) { file << v << ' '; }
+		file << '\n';
+	}
 
-	for (std::size_t a = 0; a < agents.size(); ++a) {
-		auto const& agent = agents[a];
+	std::cout << "Done\n";
+	return true;
+}
+
+/*
+	--distances: a missing file, or a file written for another graph, is ignored and the distances are computed again
+*/
+void read_distances(std::string const& filename, cpf::DistanceOracle& oracle) {
+	std::ifstream file(filename, std::ios::binary);
+	if (!file)
+		return;
+
+	if (oracle.load(file)) {
+		std::cout << "Distances from " << oracle.table_count() << " node(s) read from '" << filename << "'\n";
+	} else {
+		std::cout << "'" << filename << "' doesn't hold distances of this graph, ignored\n";
+	}
+}
+
+bool write_distances(std::string const& filename, cpf::DistanceOracle const& oracle) {
+	std::ofstream file(filename, std::ios::binary);
+	if (!file) {
+		std::cerr << "Couldn't open distance file '" << filename << "'\n";
+		return false;
+	}
+	std::cout << "Writing the distances from " << oracle.table_count() << " node(s) to '" << filename << "'... ";
+	oracle.save(file);
+	std::cout << "Done\n";
+	return true;
+}
+
+/*
+	--replan: the instance is planned again with the previous plan as phase hints, then the changes of the delta are
+	applied to the same replanner, which plans again from the solver of the first plan. The agents which left are
+	dropped from the plan written, and from the instance written by --replanned-input
+*/
+int replan(
+	cpf::CmdArgMap const& args,
+	cpf::Graph const& graph,
+	std::vector<cpf::Agent> const& agents,
+	cpf::PlanningOptions const& options,
+	std::string const& previous_filename) {
+	std::string delta_filename;
+	if (!cpf::get_argument_as_string(args, "delta", delta_filename)) {
+		std::cerr << "Missing the changes to replan after, --delta\n";
+		return 3;
+	}
+
+	std::ifstream previous_file(previous_filename);
+	std::ifstream delta_file(delta_filename);
+	if (!previous_file || !delta_file) {
+		std::cerr << "Unable to read file '" << (previous_file ? delta_filename : previous_filename) << "'\n";
+		return 2;
+	}
+
+	cpf::Replanner replanner(
+		graph, agents, options.amo_encoding, static_cast<std::size_t>(options.makespan_interval.second));
+	cpf::Delta delta;
+	try {
+		replanner.warm_start(read_paths(previous_file));
+		delta = cpf::read_delta(delta_file);
+	} catch (std::runtime_error const& e) {
+		std::cerr << e.what() << '\n';
+		return 2;
+	}
 
-		if (initial_nodes_with_agents.at(agent.initial) < agents.size()) {
-			throw std::runtime_error("Agent already exists at node " + std::to_string(agent.initial));
+	auto timed_plan = [&](char const* what, std::vector<std::vector<cpf::node_t>>& paths) {
+		auto clock_begin = std::chrono::steady_clock::now();
+		auto status		 = replanner.plan(paths);
+		std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - clock_begin;
+		std::cout << what << " in " << duration.count() << "ms";
+		if (status == cpf::Replanner::Status::Solved) {
+			std::cout << ", makespan " << paths.front().size() - 1;
 		}
-		initial_nodes_with_agents[agent.initial] = a;
+		std::cout << '\n';
+		return status;
+	};
 
-		if (goal_nodes_with_agents.at(agent.goal) < agents.size()) {
-			throw std::runtime_error("Agent already exists at node " + std::to_string(agent.goal));
+	current_global_replanner = &replanner;
+	std::vector<std::vector<cpf::node_t>> paths;
+	auto status = timed_plan("Planned before the changes", paths);
+	if (status == cpf::Replanner::Status::Solved) {
+		try {
+			replanner.apply(delta);
+		} catch (std::runtime_error const& e) {
+			std::cerr << e.what() << '\n';
+			return 2;
 		}
-		goal_nodes_with_agents[agent.goal] = a;
+		status = timed_plan("Replanned", paths);
 	}
+	current_global_replanner = nullptr;
 
-	// Init
-	for (std::size_t a = 0; a < agents.size(); ++a) {
-		for (std::size_t v = 0; v < graph.size(); ++v) {
-			if (context.contains(0, a, v)) {
-				auto x = context.get_var(0, a, v);
-				if (initial_nodes_with_agents[v] == a) {
-					context.push(x);
-				} else {
-					context.push(!x);
-				}
-			}
+	if (status == cpf::Replanner::Status::Interrupted) {
+		std::cout << "No solution found in time\n";
+		return 1;
+	}
+
+	std::vector<cpf::Agent> active_agents;
+	for (std::size_t a = 0; a < replanner.current_agents().size(); ++a) {
+		if (replanner.is_active(a)) {
+			active_agents.push_back(replanner.current_agents()[a]);
 		}
 	}
 
-	// Goal
-	for (std::size_t a = 0; a < agents.size(); ++a) {
-		for (std::size_t v = 0; v < graph.size(); ++v) {
-			if (context.contains(makespan, a, v)) {
-				auto x = context.get_var(makespan, a, v);
-				if (goal_nodes_with_agents[v] == a) {
-					context.push(x);
-				} else {
-					context.push(!x);
-				}
-			}
+	if (status == cpf::Replanner::Status::NoSolution) {
+		auto reason = cpf::find_infeasibility(replanner.current_graph(), active_agents);
+		if (!reason.empty()) {
+			std::cout << reason << '\n';
 		}
+		std::cout << "No solution found within the bounds\n";
+		return 1;
 	}
 
-	return true;
+	std::vector<std::vector<cpf::node_t>> active_paths;
+	std::cout << "Path of all agents:\n";
+	for (std::size_t a = 0; a < paths.size(); ++a) {
+		if (!replanner.is_active(a))
+			continue;
+
+		std::cout << "\tAgent #" << a << ": ";
+		for (auto v : paths[a]) { std::cout << "#" << v << ", "; }
+		std::cout << '\n';
+		active_paths.push_back(std::move(paths[a]));
+	}
+
+	std::string output_file;
+	if (cpf::get_argument_as_string(args, "output", output_file) && !write_paths(output_file, active_paths))
+		return 1;
+
+	std::string instance_file;
+	if (cpf::get_argument_as_string(args, "replanned-input", instance_file)) {
+		std::ofstream file(instance_file);
+		if (!file) {
+			std::cerr << "Couldn't open output file '" << instance_file << "'\n";
+			return 1;
+		}
+		cpf::serialize(file, replanner.current_graph(), active_agents);
+	}
+
+	return 0;
 }
 
 int main(int argc, char** argv) {
@@ -344,8 +429,10 @@ int main(int argc, char** argv) {
 		return 0;
 	}
 
+	bool use_service = cpf::has_argument(args, "serve");
+
 	std::string input_filename;
-	if (!cpf::get_argument_as_string(args, "input", input_filename)) {
+	if (!cpf::get_argument_as_string(args, "input", input_filename) && !use_service) {
 		std::cerr << "Missing input file\n";
 		print_help(argv[0]);
 		return 3;
@@ -353,31 +440,104 @@ int main(int argc, char** argv) {
 
 	int max_cpu = get_max_cpu_from_args(args);
 
-	std::pair<int, int> makespan_interval = { get_min_makespan(args), get_max_makespan(args) };
-	// bool verify_solution_exists = !cpf::has_argument(args, "trust");
-	bool use_mdd = !cpf::has_argument(args, "no-mdd");
+	bool verify_solution_exists = !cpf::has_argument(args, "trust");
+	bool use_independence		= cpf::has_argument(args, "independence");
+
+	cpf::PlanningOptions options;
+	options.makespan_interval = { get_min_makespan(args), get_max_makespan(args) };
+	options.use_mdd			  = !cpf::has_argument(args, "no-mdd");
+	options.use_incremental	  = cpf::has_argument(args, "incremental");
+	options.use_hints		  = !cpf::has_argument(args, "no-hints");
+	options.lazy_conflicts	  = cpf::has_argument(args, "lazy");
+	options.pairwise_pruning  = cpf::has_argument(args, "pairwise-pruning");
+	if (options.lazy_conflicts && !options.use_incremental) {
+		std::cerr << "The lazy conflicts are added to the solver between two solves, they require --incremental\n";
+		print_help(argv[0]);
+		return 3;
+	}
+	if (options.pairwise_pruning && !options.use_mdd) {
+		std::cerr << "The pairwise pruning prunes the mdds, it can't be used with --no-mdd\n";
+		print_help(argv[0]);
+		return 3;
+	}
 
-	std::ifstream ifile(input_filename);
-	if (!ifile) {
-		std::cerr << "Unable to read file '" << input_filename << "'\n";
-		return 2;
+	if (!get_amo_encoding(args, options.amo_encoding)) {
+		std::cerr << "Unknown at most one encoding\n";
+		print_help(argv[0]);
+		return 3;
 	}
-	auto deserialized_data = cpf::deserialize(ifile);
-	auto& graph			   = deserialized_data.first;
-	auto& agents		   = deserialized_data.second;
 
-	init_glucose(max_cpu);
+	if (use_service) {
+		// The answers are the only output, and an interrupted service just stops
+		std::ios::sync_with_stdio(false);
+		cpf::PlanningService service(
+			get_workers(args), options.amo_encoding, static_cast<std::size_t>(options.makespan_interval.second));
+		service.serve(std::cin, std::cout);
+		return 0;
+	}
 
-	cpf::Context context;
-	std::vector<bool> res;
+	cpf::ThreadPool generation_pool(get_generation_threads(args));
 
-	// Create the mdds
-	std::vector<cpf::MDD> mdds;
-	if (use_mdd) {
-		mdds.reserve(agents.size());
-		for (auto const& agent : agents) { mdds.emplace_back(graph, agent); }
+	options.solver_threads = get_solver_threads(args);
+	if (options.solver_threads > 1 && options.use_incremental) {
+		std::cerr << "The portfolio solver can't be used incrementally\n";
+		print_help(argv[0]);
+		return 3;
 	}
 
+	if (!get_search_strategy(args, options.search_strategy)) {
+		std::cerr << "Unknown search strategy\n";
+		print_help(argv[0]);
+		return 3;
+	}
+
+	if (!get_objective(args, options.objective)) {
+		std::cerr << "Unknown objective\n";
+		print_help(argv[0]);
+		return 3;
+	}
+
+	options.speculative_window = get_speculative_window(args);
+	if (options.speculative_window > 1 && options.search_strategy != cpf::SearchStrategy::Linear) {
+		std::cerr << "The speculative search only tries the makespans in increasing order\n";
+		print_help(argv[0]);
+		return 3;
+	}
+	if (options.speculative_window > 1 && (options.use_incremental || options.solver_threads > 1)) {
+		std::cerr << "The speculative search uses its own sequential solvers, it can't be used with --incremental or "
+					 "--threads\n";
+		print_help(argv[0]);
+		return 3;
+	}
+
+	std::pair<cpf::Graph, std::vector<cpf::Agent>> deserialized_data;
+	try {
+		deserialized_data = cpf::deserialize_file(input_filename);
+	} catch (std::exception const& e) {
+		std::cerr << e.what() << '\n';
+		return 2;
+	}
+	auto& graph	 = deserialized_data.first;
+	auto& agents = deserialized_data.second;
+
+	// Plan given as phase hints, in the format of --output
+	std::vector<std::vector<cpf::node_t>> hints;
+	std::string hint_filename;
+	if (cpf::get_argument_as_string(args, "hint", hint_filename)) {
+		std::ifstream hint_file(hint_filename);
+		if (!hint_file) {
+			std::cerr << "Unable to read file '" << hint_filename << "'\n";
+			return 2;
+		}
+		hints = read_paths(hint_file);
+		if (hints.size() != agents.size()) {
+			std::cerr << "The plan of '" << hint_filename << "' doesn't have a path for all agents\n";
+			return 2;
+		}
+	}
+
+	init_glucose(max_cpu);
+
 	auto clock_all_begin   = std::chrono::steady_clock::now();
 	auto report_total_time = [&]() {
 		auto clock_all_end								   = std::chrono::steady_clock::now();
@@ -385,90 +545,80 @@ int main(int argc, char** argv) {
 		std::cout << "Total time: " << duration.count() << "ms\n";
 	};
 
-	// Start iterative methods
+	std::string previous_filename;
+	if (cpf::get_argument_as_string(args, "replan", previous_filename)) {
+		auto ret = replan(args, graph, agents, options, previous_filename);
+		report_total_time();
+		return ret;
+	}
 
-	int makespan;
-	for (makespan = makespan_interval.first; makespan <= makespan_interval.second && !interrupted; ++makespan) {
-		auto clock_begin = std::chrono::steady_clock::now();
-		auto report_time = [&]() {
-			auto clock_end									   = std::chrono::steady_clock::now();
-			std::chrono::duration<double, std::milli> duration = clock_end - clock_begin;
-			std::cout << "\tTook " << duration.count() << "ms\n";
-		};
-
-		std::cout << "Generating SAT problem with a bounded makespan of " << makespan << "...\n";
-		if (!build_context(context, graph, agents, makespan, use_mdd ? &mdds : nullptr)) {
-			report_time();
-			continue;
+	if (verify_solution_exists) {
+		auto reason = cpf::find_infeasibility(graph, agents);
+		if (!reason.empty()) {
+			std::cout << reason << '\n';
+			report_total_time();
+			std::cout << "No solution exists\n";
+			return 1;
 		}
 
-		std::cout << "\t#Variables: " << context.variables_count() << '\n';
-		std::cout << "\t#Clauses: " << context.clauses_count() << '\n';
+		// A plan of makespan M can be extended by waiting on the goals, so M bounds the makespans to try
+		std::vector<std::vector<cpf::node_t>> prioritized_paths;
+		if (!agents.empty() && cpf::plan_prioritized(graph, agents, prioritized_paths)) {
+			auto makespan = static_cast<int>(prioritized_paths.front().size() - 1);
+			std::cout << "Upper bound of the makespan (prioritized planning): " << makespan << '\n';
+			options.makespan_interval.second = std::max(
+				options.makespan_interval.first, std::min(options.makespan_interval.second, makespan));
+		}
+	}
 
-		std::cout << "\tSolving...\n";
-		if (interrupted || solve(context, res)) {
-			report_time();
-			break;
+	// Shared by the mdds of all the agents, and of all the groups with --independence
+	cpf::DistanceOracle oracle(graph);
+	std::string distances_filename;
+	bool use_distance_file = cpf::get_argument_as_string(args, "distances", distances_filename);
+	if (use_distance_file) {
+		read_distances(distances_filename, oracle);
+	}
+	auto known_tables = oracle.table_count();
+	if (cpf::has_argument(args, "all-distances")) {
+		auto size = graph.size() * graph.size() * sizeof(std::uint16_t);
+		if (size > ALL_DISTANCES_WARNING_SIZE) {
+			std::cout << "Warning: the distances between all the nodes take at least " << (size >> 20) << "MB\n";
 		}
+		oracle.compute_all(generation_pool);
+	}
 
-		report_time();
-		std::cout << "\tFailed to solve.\n";
+	std::vector<std::vector<cpf::node_t>> paths;
+	auto status = use_independence
+		? cpf::plan_independent_groups(graph, agents, options, generation_pool, oracle, hints, interruption, paths)
+		: cpf::plan(graph, agents, options, generation_pool, oracle, hints, interruption, paths);
+	report_total_time();
+
+	if (use_distance_file && oracle.table_count() != known_tables) {
+		write_distances(distances_filename, oracle);
 	}
 
-	if (interrupted) {
-		std::cout << "\tFailed to solve.\n";
-		report_total_time();
+	if (status == cpf::PlanStatus::Interrupted) {
 		std::cout << "No solution found in time\n";
 		return 1;
 	}
 
-	if (makespan > makespan_interval.second) {
-		std::cout << "\tFailed to solve.\n";
-		report_total_time();
+	if (status == cpf::PlanStatus::NoSolution) {
 		std::cout << "No solution found within the bounds\n";
 		return 1;
 	}
 
-	std::cout << "\tSuccessfully solved\n";
-	report_total_time();
-
 	// Display path
 	std::cout << "Path of all agents:\n";
 	for (std::size_t a = 0; a < agents.size(); ++a) {
 		std::cout << "\tAgent #" << a << ": ";
-		for (std::size_t t = 0; t <= makespan; ++t) {
-			for (std::size_t v = 0; v < graph.size(); ++v) {
-				if (context.contains(t, a, v) && res[context.get_var(t, a, v).id]) {
-					std::cout << "#" << v << ", ";
-				}
-			}
-		}
+		for (auto v : paths[a]) { std::cout << "#" << v << ", "; }
 		std::cout << '\n';
 	}
 
 	// Writing path to file if requested
 	std::string output_file;
-	if (cpf::get_argument_as_string(args, "output", output_file)) {
-		std::ofstream file(output_file);
-		if (!file) {
-			std::cerr << "Couldn't open output file '" << output_file << "'\n";
-			return 1;
-		}
-		std::cout << "Writing to '" << output_file << "'... ";
-
-		for (std::size_t a = 0; a < agents.size(); ++a) {
-			for (std::size_t t = 0; t <= makespan; ++t) {
-				for (std::size_t v = 0; v < graph.size(); ++v) {
-					if (context.contains(t, a, v) && res[context.get_var(t, a, v).id]) {
-						file << v << ' ';
-					}
-				}
-			}
-			file << '\n';
-		}
-
-		std::cout << "Done\n";
-	}
+	if (cpf::get_argument_as_string(args, "output", output_file) && !write_paths(output_file, paths))
+		return 1;
 
 	return 0;
 }
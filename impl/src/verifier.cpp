@@ -55,10 +55,9 @@ int main(int argc, char** argv) {
 		return 1;
 	}
 
-	std::ifstream graph_file(graph_filename);
 	std::ifstream path_file(path_filename);
 
-	auto cpf	 = cpf::deserialize(graph_file);
+	auto cpf	 = cpf::deserialize_file(graph_filename);
 	auto& graph	 = cpf.first;
 	auto& agents = cpf.second;
 